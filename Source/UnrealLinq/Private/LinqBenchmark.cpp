@@ -0,0 +1,860 @@
+#include "Misc/AutomationTest.h"
+#include "Linq.h"
+#include "LinqView.h"
+
+namespace LinqBenchmark
+{
+	template <typename TBody>
+	double MeasureSeconds(int Repeat, TBody Body)
+	{
+		const double Start = FPlatformTime::Seconds();
+		for (int i = 0; i < Repeat; ++i)
+		{
+			Body();
+		}
+		return (FPlatformTime::Seconds() - Start) / Repeat;
+	}
+
+	struct FAllocationStats
+	{
+	public:
+		int64 Allocations = 0;
+		int64 Bytes = 0;
+	};
+
+	// Set only on the thread running CountAllocations, so task graph and AsParallel workers are never counted
+	// and never touch the counters.
+	static thread_local FAllocationStats* ActiveStats = nullptr;
+
+	// Forwards to the engine allocator and counts the allocations of a thread with ActiveStats set.
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		FMalloc* Inner;
+
+		explicit FCountingMalloc(FMalloc* Inner) : Inner(Inner)
+		{
+		}
+
+		static void Count(SIZE_T Size)
+		{
+			if (FAllocationStats* Stats = ActiveStats)
+			{
+				Stats->Allocations += 1;
+				Stats->Bytes += Size;
+			}
+		}
+
+		virtual void* Malloc(SIZE_T Size, uint32 Alignment) override
+		{
+			Count(Size);
+			return Inner->Malloc(Size, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Size, uint32 Alignment) override
+		{
+			if (Size > 0)
+			{
+				Count(Size);
+			}
+			return Inner->Realloc(Original, Size, Alignment);
+		}
+
+		virtual void Free(void* Original) override
+		{
+			Inner->Free(Original);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Size, uint32 Alignment) override
+		{
+			return Inner->QuantizeSize(Size, Alignment);
+		}
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+		{
+			return Inner->GetAllocationSize(Original, SizeOut);
+		}
+
+		virtual void Trim(bool bTrimThreadCaches) override
+		{
+			Inner->Trim(bTrimThreadCaches);
+		}
+
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return Inner->IsInternallyThreadSafe();
+		}
+
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return Inner->GetDescriptiveName();
+		}
+	};
+
+	// The proxy is installed once and never removed or modified afterwards, so other threads only ever see a
+	// fixed forwarding allocator; what is counted is decided per thread through ActiveStats.
+	inline void InstallCountingMalloc()
+	{
+		static FCountingMalloc* Counting = nullptr;
+		if (Counting == nullptr)
+		{
+			Counting = new FCountingMalloc(GMalloc);
+			GMalloc = Counting;
+		}
+	}
+
+	template <typename TBody>
+	FAllocationStats CountAllocations(TBody Body)
+	{
+		InstallCountingMalloc();
+		FAllocationStats Stats;
+		ActiveStats = &Stats;
+		Body();
+		ActiveStats = nullptr;
+		return Stats;
+	}
+
+	struct FPayload
+	{
+	public:
+		int Key = 0;
+		float Padding[15] = {};
+	};
+	static_assert(sizeof(FPayload) == 64, "The payload benchmark expects a 64-byte element");
+
+	inline int Key(const int& X)
+	{
+		return X;
+	}
+
+	inline int Key(const FPayload& X)
+	{
+		return X.Key;
+	}
+
+	inline int Key(const FString& X)
+	{
+		return static_cast<int>(GetTypeHash(X) & 0xFFFFF);
+	}
+
+	template <typename T>
+	T MakeElement(int Value);
+
+	template <>
+	inline int MakeElement<int>(int Value)
+	{
+		return Value;
+	}
+
+	template <>
+	inline FPayload MakeElement<FPayload>(int Value)
+	{
+		FPayload Payload;
+		Payload.Key = Value;
+		return Payload;
+	}
+
+	template <>
+	inline FString MakeElement<FString>(int Value)
+	{
+		return FString::FromInt(Value);
+	}
+
+	// Runs both bodies enough times to cover ~2M elements, then once more each under the allocation counter.
+	template <typename TLinq, typename THandWritten>
+	void RunCase(FAutomationTestBase& Test, const TCHAR* TypeName, const TCHAR* CaseName, int Num, TLinq Linq, THandWritten HandWritten)
+	{
+		const int Repeat = FMath::Max(1, 2000000 / Num);
+		int64 LinqResult = 0;
+		int64 HandWrittenResult = 0;
+		const double LinqSeconds = MeasureSeconds(Repeat, [&Linq, &LinqResult]() { LinqResult = Linq(); });
+		const double HandWrittenSeconds = MeasureSeconds(Repeat, [&HandWritten, &HandWrittenResult]() { HandWrittenResult = HandWritten(); });
+		const FAllocationStats LinqAllocations = CountAllocations([&Linq]() { Linq(); });
+		const FAllocationStats HandWrittenAllocations = CountAllocations([&HandWritten]() { HandWritten(); });
+
+		Test.AddInfo(FString::Printf(TEXT("%-8s %-32s N=%-8d linq %9.2f ns/elem %5lld allocs %10lld B | hand-written %9.2f ns/elem %5lld allocs %10lld B"),
+			TypeName, CaseName, Num,
+			LinqSeconds * 1e9 / Num, LinqAllocations.Allocations, LinqAllocations.Bytes,
+			HandWrittenSeconds * 1e9 / Num, HandWrittenAllocations.Allocations, HandWrittenAllocations.Bytes));
+		Test.TestEqual(*FString::Printf(TEXT("%s %s N=%d 결과 검증"), TypeName, CaseName, Num), LinqResult, HandWrittenResult);
+	}
+
+	template <typename T>
+	void RunSuite(FAutomationTestBase& Test, const TCHAR* TypeName, int Num)
+	{
+		TArray<T> Source;
+		TArray<T> Second;
+		TArray<int> HalfKeys;
+		Source.Reserve(Num);
+		Second.Reserve(Num);
+		for (int i = 0; i < Num; ++i)
+		{
+			Source.Emplace(MakeElement<T>(FMath::RandHelper(Num)));
+			Second.Emplace(MakeElement<T>(FMath::RandHelper(Num)));
+		}
+		for (int i = 0; i < Num / 2; ++i)
+		{
+			HalfKeys.Emplace(Key(Source[i]));
+		}
+
+		RunCase(Test, TypeName, TEXT("ForEach"), Num,
+			[&Source]() { int64 Sum = 0; From(Source) >> ForEach([&Sum](const T& X) { Sum += Key(X); }); return Sum; },
+			[&Source]() { int64 Sum = 0; for (const T& X : Source) { Sum += Key(X); } return Sum; });
+
+		RunCase(Test, TypeName, TEXT("Where >> ToArray"), Num,
+			[&Source]() { return (int64)(From(Source) >> Where([](const T& X) { return Key(X) % 2 == 0; }) >> ToArray()).Num(); },
+			[&Source]()
+			{
+				TArray<T> Result;
+				for (const T& X : Source)
+				{
+					if (Key(X) % 2 == 0)
+					{
+						Result.Emplace(X);
+					}
+				}
+				return (int64)Result.Num();
+			});
+
+		RunCase(Test, TypeName, TEXT("Where >> Select >> ToArray"), Num,
+			[&Source]() { return (int64)(From(Source) >> Where([](const T& X) { return Key(X) % 2 == 0; }) >> Select([](const T& X) { return Key(X) * 3; }) >> ToArray()).Num(); },
+			[&Source]()
+			{
+				TArray<int> Result;
+				for (const T& X : Source)
+				{
+					if (Key(X) % 2 == 0)
+					{
+						Result.Emplace(Key(X) * 3);
+					}
+				}
+				return (int64)Result.Num();
+			});
+
+		RunCase(Test, TypeName, TEXT("OrderBy >> ToArray"), Num,
+			[&Source]()
+			{
+				TArray<T> Result = From(Source) >> OrderBy([](const T& X) { return Key(X); }) >> ToArray();
+				return (int64)Key(Result[0]) + Key(Result[Result.Num() - 1]);
+			},
+			[&Source]()
+			{
+				TArray<T> Result = Source;
+				Algo::StableSort(Result, [](const T& L, const T& R) { return Key(L) < Key(R); });
+				return (int64)Key(Result[0]) + Key(Result[Result.Num() - 1]);
+			});
+
+		RunCase(Test, TypeName, TEXT("OrderBy >> ThenBy >> ToArray"), Num,
+			[&Source]()
+			{
+				TArray<T> Result = From(Source) >> OrderBy([](const T& X) { return Key(X) % 16; }) >> ThenBy([](const T& X) { return Key(X); }) >> ToArray();
+				return (int64)Key(Result[0]) + Key(Result[Result.Num() - 1]);
+			},
+			[&Source]()
+			{
+				TArray<T> Result = Source;
+				Algo::StableSort(Result, [](const T& L, const T& R) { return Key(L) % 16 != Key(R) % 16 ? Key(L) % 16 < Key(R) % 16 : Key(L) < Key(R); });
+				return (int64)Key(Result[0]) + Key(Result[Result.Num() - 1]);
+			});
+
+		auto SortQuery = Query<const T>() >> OrderBy([](const T& X) { return Key(X); });
+		TArray<const T*> SortScratch;
+		RunCase(Test, TypeName, TEXT("Query OrderBy (reused)"), Num,
+			[&Source, &SortQuery]()
+			{
+				int64 Ends = 0;
+				const T* Last = nullptr;
+				SortQuery.Rebind(Source) >> ForEach([&Ends, &Last](const T& X) { Ends += Last == nullptr ? Key(X) : 0; Last = &X; });
+				return Ends + Key(*Last);
+			},
+			[&Source, &SortScratch]()
+			{
+				SortScratch.Reset();
+				for (const T& X : Source)
+				{
+					SortScratch.Emplace(&X);
+				}
+				Algo::StableSort(SortScratch, [](const T* L, const T* R) { return Key(*L) < Key(*R); });
+				return (int64)Key(*SortScratch[0]) + Key(*SortScratch.Last());
+			});
+
+		// A few elements change per frame: the view applies the deltas, the hand-written loop re-sorts everything.
+		TArray<T> ViewLive = Source;
+		TArray<T> SortLive = Source;
+		int ViewStep = 0;
+		int SortStep = 0;
+		auto SortView = Query<const T>() >> OrderBy([](const T& X) { return Key(X); }) >> ToView();
+		SortView.Build(ViewLive);
+		RunCase(Test, TypeName, TEXT("View OrderBy (8 updates)"), Num,
+			[&ViewLive, &Second, &ViewStep, &SortView, Num]()
+			{
+				for (int i = 0; i < 8; ++i, ViewStep = (ViewStep + 1) % Num)
+				{
+					const int Id = (ViewStep * 7919) % Num;
+					ViewLive[Id] = Second[ViewStep % Num];
+					SortView.Update(Id, ViewLive[Id]);
+				}
+				return (int64)Key(SortView.Results()[0]) + Key(SortView.Results().Last());
+			},
+			[&SortLive, &Second, &SortStep, &SortScratch, Num]()
+			{
+				for (int i = 0; i < 8; ++i, SortStep = (SortStep + 1) % Num)
+				{
+					SortLive[(SortStep * 7919) % Num] = Second[SortStep % Num];
+				}
+				SortScratch.Reset();
+				for (const T& X : SortLive)
+				{
+					SortScratch.Emplace(&X);
+				}
+				Algo::StableSort(SortScratch, [](const T* L, const T* R) { return Key(*L) < Key(*R); });
+				return (int64)Key(*SortScratch[0]) + Key(*SortScratch.Last());
+			});
+
+		RunCase(Test, TypeName, TEXT("TopBy(10)"), Num,
+			[&Source]()
+			{
+				int64 Sum = 0;
+				From(Source) >> TopBy(10, [](const T& X) { return Key(X); }) >> ForEach([&Sum](const T& X) { Sum += Key(X); });
+				return Sum;
+			},
+			[&Source]()
+			{
+				TArray<T> Sorted = Source;
+				Algo::Sort(Sorted, [](const T& L, const T& R) { return Key(L) < Key(R); });
+				int64 Sum = 0;
+				for (int i = 0; i < FMath::Min(10, Sorted.Num()); ++i)
+				{
+					Sum += Key(Sorted[i]);
+				}
+				return Sum;
+			});
+
+		RunCase(Test, TypeName, TEXT("Reverse >> ToArray"), Num,
+			[&Source]() { return (int64)Key((From(Source) >> Reverse() >> ToArray())[0]); },
+			[&Source]()
+			{
+				TArray<T> Result;
+				Result.Reserve(Source.Num());
+				for (int i = Source.Num() - 1; i >= 0; --i)
+				{
+					Result.Emplace(Source[i]);
+				}
+				return (int64)Key(Result[0]);
+			});
+
+		RunCase(Test, TypeName, TEXT("Skip >> Take >> ToArray"), Num,
+			[&Source, Num]() { return (int64)(From(Source) >> Skip(Num / 4) >> Take(Num / 2) >> ToArray()).Num(); },
+			[&Source, Num]()
+			{
+				TArray<T> Result;
+				for (int i = Num / 4; i < FMath::Min(Num / 4 + Num / 2, Source.Num()); ++i)
+				{
+					Result.Emplace(Source[i]);
+				}
+				return (int64)Result.Num();
+			});
+
+		RunCase(Test, TypeName, TEXT("Where >> Take(10)"), Num,
+			[&Source]() { return (int64)(From(Source) >> Where([](const T& X) { return Key(X) % 2 == 0; }) >> Take(10) >> ToArray()).Num(); },
+			[&Source]()
+			{
+				TArray<T> Result;
+				for (const T& X : Source)
+				{
+					if (Key(X) % 2 == 0 && Result.Emplace(X) == 9)
+					{
+						break;
+					}
+				}
+				return (int64)Result.Num();
+			});
+
+		RunCase(Test, TypeName, TEXT("TakeWhile >> Count"), Num,
+			[&Source]() { return (int64)(From(Source) >> TakeWhile([](const T& X) { return Key(X) >= 0; }) >> Count()); },
+			[&Source]()
+			{
+				int64 Result = 0;
+				for (const T& X : Source)
+				{
+					if (Key(X) < 0)
+					{
+						break;
+					}
+					++Result;
+				}
+				return Result;
+			});
+
+		RunCase(Test, TypeName, TEXT("Where >> Count"), Num,
+			[&Source]() { return (int64)(From(Source) >> Where([](const T& X) { return Key(X) % 3 == 0; }) >> Count()); },
+			[&Source]()
+			{
+				int64 Result = 0;
+				for (const T& X : Source)
+				{
+					Result += Key(X) % 3 == 0 ? 1 : 0;
+				}
+				return Result;
+			});
+
+		RunCase(Test, TypeName, TEXT("Any (no match)"), Num,
+			[&Source]() { return (int64)(From(Source) >> Any([](const T& X) { return Key(X) < 0; })); },
+			[&Source]()
+			{
+				for (const T& X : Source)
+				{
+					if (Key(X) < 0)
+					{
+						return (int64)1;
+					}
+				}
+				return (int64)0;
+			});
+
+		RunCase(Test, TypeName, TEXT("Select >> Sum"), Num,
+			[&Source]() { return From(Source) >> Select([](const T& X) { return (int64)Key(X); }) >> Sum(); },
+			[&Source]()
+			{
+				int64 Sum = 0;
+				for (const T& X : Source)
+				{
+					Sum += Key(X);
+				}
+				return Sum;
+			});
+
+		RunCase(Test, TypeName, TEXT("Select >> Max"), Num,
+			[&Source]() { return (int64)(From(Source) >> Select([](const T& X) { return Key(X); }) >> Max()).GetValue(); },
+			[&Source]()
+			{
+				int Best = Key(Source[0]);
+				for (const T& X : Source)
+				{
+					Best = FMath::Max(Best, Key(X));
+				}
+				return (int64)Best;
+			});
+
+		RunCase(Test, TypeName, TEXT("DistinctBy >> Count"), Num,
+			[&Source]() { return (int64)(From(Source) >> DistinctBy([](const T& X) { return Key(X); }) >> Count()); },
+			[&Source]()
+			{
+				TSet<int> Keys;
+				int64 Result = 0;
+				for (const T& X : Source)
+				{
+					bool IsAlreadyInSet;
+					Keys.Emplace(Key(X), &IsAlreadyInSet);
+					Result += IsAlreadyInSet ? 0 : 1;
+				}
+				return Result;
+			});
+
+		RunCase(Test, TypeName, TEXT("GroupBy >> Count"), Num,
+			[&Source]() { return (int64)(From(Source) >> GroupBy([](const T& X) { return Key(X) % 64; }) >> Count()); },
+			[&Source]()
+			{
+				TMap<int, TArray<T>> Groups;
+				for (const T& X : Source)
+				{
+					Groups.FindOrAdd(Key(X) % 64).Emplace(X);
+				}
+				return (int64)Groups.Num();
+			});
+
+		RunCase(Test, TypeName, TEXT("ExceptBy >> Count"), Num,
+			[&Source, &HalfKeys]() { return (int64)(From(Source) >> ExceptBy(From(HalfKeys), [](const T& X) { return Key(X); }) >> Count()); },
+			[&Source, &HalfKeys]()
+			{
+				TSet<int> Keys;
+				for (int X : HalfKeys)
+				{
+					Keys.Emplace(X);
+				}
+				int64 Result = 0;
+				for (const T& X : Source)
+				{
+					Result += Keys.Contains(Key(X)) ? 0 : 1;
+				}
+				return Result;
+			});
+
+		RunCase(Test, TypeName, TEXT("IntersectBy >> Count"), Num,
+			[&Source, &HalfKeys]() { return (int64)(From(Source) >> IntersectBy(From(HalfKeys), [](const T& X) { return Key(X); }) >> Count()); },
+			[&Source, &HalfKeys]()
+			{
+				TSet<int> Keys;
+				for (int X : HalfKeys)
+				{
+					Keys.Emplace(X);
+				}
+				int64 Result = 0;
+				for (const T& X : Source)
+				{
+					Result += Keys.Contains(Key(X)) ? 1 : 0;
+				}
+				return Result;
+			});
+
+		RunCase(Test, TypeName, TEXT("UnionBy >> Count"), Num,
+			[&Source, &Second]() { return (int64)(From(Source) >> UnionBy(From(Second), [](const T& X) { return Key(X); }) >> Count()); },
+			[&Source, &Second]()
+			{
+				TSet<int> Keys;
+				for (const T& X : Source)
+				{
+					Keys.Emplace(Key(X));
+				}
+				for (const T& X : Second)
+				{
+					Keys.Emplace(Key(X));
+				}
+				return (int64)Keys.Num();
+			});
+
+		RunCase(Test, TypeName, TEXT("ToMap"), Num,
+			[&Source]() { return (int64)(From(Source) >> ToMap([](const T& X) { return Key(X); }, [](const T& X) { return X; })).Num(); },
+			[&Source]()
+			{
+				TMap<int, T> Map;
+				for (const T& X : Source)
+				{
+					Map.Add(Key(X), X);
+				}
+				return (int64)Map.Num();
+			});
+
+		RunCase(Test, TypeName, TEXT("Select >> ToSet"), Num,
+			[&Source]() { return (int64)(From(Source) >> Select([](const T& X) { return Key(X); }) >> ToSet()).Num(); },
+			[&Source]()
+			{
+				TSet<int> Set;
+				for (const T& X : Source)
+				{
+					Set.Emplace(Key(X));
+				}
+				return (int64)Set.Num();
+			});
+
+		RunCase(Test, TypeName, TEXT("SkipWhile >> Count"), Num,
+			[&Source, Num]() { return (int64)(From(Source) >> SkipWhile([Num](const T& X) { return Key(X) < Num / 2; }) >> Count()); },
+			[&Source, Num]()
+			{
+				int Index = 0;
+				while (Index < Source.Num() && Key(Source[Index]) < Num / 2)
+				{
+					++Index;
+				}
+				return (int64)(Source.Num() - Index);
+			});
+
+		RunCase(Test, TypeName, TEXT("All"), Num,
+			[&Source]() { return (int64)(From(Source) >> All([](const T& X) { return Key(X) >= 0; })); },
+			[&Source]()
+			{
+				for (const T& X : Source)
+				{
+					if (Key(X) < 0)
+					{
+						return (int64)0;
+					}
+				}
+				return (int64)1;
+			});
+
+		RunCase(Test, TypeName, TEXT("Select >> Contains (no match)"), Num,
+			[&Source]() { return (int64)(From(Source) >> Select([](const T& X) { return Key(X); }) >> Contains(-1)); },
+			[&Source]()
+			{
+				for (const T& X : Source)
+				{
+					if (Key(X) == -1)
+					{
+						return (int64)1;
+					}
+				}
+				return (int64)0;
+			});
+
+		RunCase(Test, TypeName, TEXT("Select >> Average"), Num,
+			[&Source]() { return (int64)(From(Source) >> Select([](const T& X) { return Key(X); }) >> Average()).GetValue(); },
+			[&Source]()
+			{
+				int64 Sum = 0;
+				for (const T& X : Source)
+				{
+					Sum += Key(X);
+				}
+				return (int64)((double)Sum / Source.Num());
+			});
+
+		RunCase(Test, TypeName, TEXT("Select >> Min"), Num,
+			[&Source]() { return (int64)(From(Source) >> Select([](const T& X) { return Key(X); }) >> Min()).GetValue(); },
+			[&Source]()
+			{
+				int Best = Key(Source[0]);
+				for (const T& X : Source)
+				{
+					Best = FMath::Min(Best, Key(X));
+				}
+				return (int64)Best;
+			});
+
+		RunCase(Test, TypeName, TEXT("Where >> First"), Num,
+			[&Source]()
+			{
+				TOptional<T> Found = From(Source) >> Where([](const T& X) { return Key(X) % 97 == 96; }) >> First();
+				return Found.IsSet() ? (int64)Key(Found.GetValue()) : (int64)-1;
+			},
+			[&Source]()
+			{
+				for (const T& X : Source)
+				{
+					if (Key(X) % 97 == 96)
+					{
+						return (int64)Key(X);
+					}
+				}
+				return (int64)-1;
+			});
+
+		RunCase(Test, TypeName, TEXT("Last / ElementAt"), Num,
+			[&Source, Num]() { return (int64)Key((From(Source) >> Last()).GetValue()) + Key((From(Source) >> ElementAt(Num / 2)).GetValue()); },
+			[&Source, Num]() { return (int64)Key(Source.Last()) + Key(Source[Num / 2]); });
+
+		RunCase(Test, TypeName, TEXT("Concat >> Where >> Count"), Num,
+			[&Source, &Second]() { return (int64)(From(Source) >> Concat(From(Second)) >> Where([](const T& X) { return Key(X) % 2 == 0; }) >> Count()); },
+			[&Source, &Second]()
+			{
+				int64 Result = 0;
+				for (const T& X : Source)
+				{
+					Result += Key(X) % 2 == 0 ? 1 : 0;
+				}
+				for (const T& X : Second)
+				{
+					Result += Key(X) % 2 == 0 ? 1 : 0;
+				}
+				return Result;
+			});
+
+		RunCase(Test, TypeName, TEXT("Zip >> Sum"), Num,
+			[&Source, &Second]() { return From(Source) >> Zip(From(Second), [](const T& L, const T& R) { return (int64)Key(L) - Key(R); }) >> Sum(); },
+			[&Source, &Second]()
+			{
+				int64 Sum = 0;
+				for (int i = 0; i < Source.Num(); ++i)
+				{
+					Sum += (int64)Key(Source[i]) - Key(Second[i]);
+				}
+				return Sum;
+			});
+
+		TArray<TArray<T>> Chunks;
+		for (int i = 0; i < Num; i += 16)
+		{
+			Chunks.Emplace(TArray<T>(Source.GetData() + i, FMath::Min(16, Num - i)));
+		}
+		RunCase(Test, TypeName, TEXT("SelectMany >> Where >> Count"), Num,
+			[&Chunks]() { return (int64)(From(Chunks) >> SelectMany([](TArray<T>& Chunk) -> TArray<T>& { return Chunk; }) >> Where([](const T& X) { return Key(X) % 2 == 0; }) >> Count()); },
+			[&Chunks]()
+			{
+				int64 Result = 0;
+				for (const TArray<T>& Chunk : Chunks)
+				{
+					for (const T& X : Chunk)
+					{
+						Result += Key(X) % 2 == 0 ? 1 : 0;
+					}
+				}
+				return Result;
+			});
+
+		RunCase(Test, TypeName, TEXT("Join >> Count"), Num,
+			[&Source, &HalfKeys]() { return (int64)(From(Source) >> Join(From(HalfKeys), [](const T& X) { return Key(X); }, [](int X) { return X; }, [](const T& X, int Y) { return Y; }) >> Count()); },
+			[&Source, &HalfKeys]()
+			{
+				TMap<int, int> Matches;
+				for (int X : HalfKeys)
+				{
+					Matches.FindOrAdd(X) += 1;
+				}
+				int64 Result = 0;
+				for (const T& X : Source)
+				{
+					const int* Found = Matches.Find(Key(X));
+					Result += Found ? *Found : 0;
+				}
+				return Result;
+			});
+
+		RunCase(Test, TypeName, TEXT("GroupJoin >> Sum"), Num,
+			[&Source, &HalfKeys]() { return From(Source) >> GroupJoin(From(HalfKeys), [](const T& X) { return Key(X); }, [](int X) { return X; }, [](const T& X, auto& Group) { return (int64)Group.MaxNum(); }) >> Sum(); },
+			[&Source, &HalfKeys]()
+			{
+				TMap<int, int> Matches;
+				for (int X : HalfKeys)
+				{
+					Matches.FindOrAdd(X) += 1;
+				}
+				int64 Result = 0;
+				for (const T& X : Source)
+				{
+					const int* Found = Matches.Find(Key(X));
+					Result += Found ? *Found : 0;
+				}
+				return Result;
+			});
+
+		RunCase(Test, TypeName, TEXT("AsParallel >> Where >> ToArray"), Num,
+			[&Source]() { return (int64)(From(Source) >> AsParallel() >> Where([](const T& X) { return Key(X) % 2 == 0; }) >> ToArray()).Num(); },
+			[&Source]()
+			{
+				TArray<T> Result;
+				for (const T& X : Source)
+				{
+					if (Key(X) % 2 == 0)
+					{
+						Result.Emplace(X);
+					}
+				}
+				return (int64)Result.Num();
+			});
+	}
+
+	template <typename T>
+	void RunSuiteSizes(FAutomationTestBase& Test, const TCHAR* TypeName)
+	{
+		for (int Num : {10, 1000, 100000, 1000000})
+		{
+			RunSuite<T>(Test, TypeName, Num);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqBenchmark_ForEach_HandWritten, "Private.LinqBenchmark.ForEach_HandWritten", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool LinqBenchmark_ForEach_HandWritten::RunTest(const FString& Parameters)
+{
+	const int Num = 1000000;
+	const int Repeat = 20;
+	TArray<int> Array;
+	Array.Reserve(Num);
+	for (int i = 0; i < Num; ++i)
+	{
+		Array.Emplace(FMath::RandHelper(1000));
+	}
+
+	int64 HandWrittenSum = 0;
+	const double HandWritten = LinqBenchmark::MeasureSeconds(Repeat, [&Array, &HandWrittenSum]()
+	{
+		int64 Sum = 0;
+		for (int i = 0; i < Array.Num(); ++i)
+		{
+			if (Array[i] % 2 == 1)
+			{
+				Sum += Array[i] * 3;
+			}
+		}
+		HandWrittenSum = Sum;
+	});
+
+	int64 PushSum = 0;
+	const double Push = LinqBenchmark::MeasureSeconds(Repeat, [&Array, &PushSum]()
+	{
+		int64 Sum = 0;
+		From(Array) >> Where([](int X) { return X % 2 == 1; }) >> Select([](int X) { return X * 3; }) >> ForEach([&Sum](int X) { Sum += X; });
+		PushSum = Sum;
+	});
+
+	int64 PullSum = 0;
+	const double Pull = LinqBenchmark::MeasureSeconds(Repeat, [&Array, &PullSum]()
+	{
+		int64 Sum = 0;
+		auto Enumerator = From(Array) >> Where([](int X) { return X % 2 == 1; }) >> Select([](int X) { return X * 3; });
+		while (Enumerator.MoveNext())
+		{
+			Sum += Enumerator.Current();
+		}
+		PullSum = Sum;
+	});
+
+	AddInfo(FString::Printf(TEXT("Where >> Select over %d ints: hand-written %.3f ms, ForEach %.3f ms, MoveNext %.3f ms"), Num, HandWritten * 1000.0, Push * 1000.0, Pull * 1000.0));
+	TestEqual(TEXT("ForEach 결과 검증"), PushSum, HandWrittenSum);
+	TestEqual(TEXT("MoveNext 결과 검증"), PullSum, HandWrittenSum);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqBenchmark_Batched_Where_ToArray, "Private.LinqBenchmark.Batched_Where_ToArray", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool LinqBenchmark_Batched_Where_ToArray::RunTest(const FString& Parameters)
+{
+	const int Num = 1000000;
+	const int Repeat = 20;
+	TArray<float> Array;
+	Array.Reserve(Num);
+	for (int i = 0; i < Num; ++i)
+	{
+		Array.Emplace(FMath::FRand());
+	}
+
+	TArray<float> HandWrittenResult;
+	const double HandWritten = LinqBenchmark::MeasureSeconds(Repeat, [&Array, &HandWrittenResult]()
+	{
+		TArray<float> Result;
+		Result.Reserve(Array.Num());
+		for (int i = 0; i < Array.Num(); ++i)
+		{
+			if (Array[i] > 0.5f)
+			{
+				Result.Emplace(Array[i] * 2.0f);
+			}
+		}
+		HandWrittenResult = MoveTemp(Result);
+	});
+
+	TArray<float> BatchedResult;
+	const double Batched = LinqBenchmark::MeasureSeconds(Repeat, [&Array, &BatchedResult]()
+	{
+		BatchedResult = From(Array) >> Where([](float X) { return X > 0.5f; }) >> Select([](float X) { return X * 2.0f; }) >> ToArray();
+	});
+
+	TArray<float> PushResult;
+	const double Push = LinqBenchmark::MeasureSeconds(Repeat, [&Array, &PushResult]()
+	{
+		TArray<float> Result;
+		Result.Reserve(Array.Num());
+		From(Array) >> Where([](float X) { return X > 0.5f; }) >> Select([](float X) { return X * 2.0f; }) >> ForEach([&Result](float X) { Result.Emplace(X); });
+		PushResult = MoveTemp(Result);
+	});
+
+	AddInfo(FString::Printf(TEXT("Where >> Select >> ToArray over %d floats: hand-written %.3f ms, batched %.3f ms, ForEach %.3f ms"), Num, HandWritten * 1000.0, Batched * 1000.0, Push * 1000.0));
+	TestEqual(TEXT("Batch 결과 검증"), BatchedResult.Num(), HandWrittenResult.Num());
+	TestEqual(TEXT("ForEach 결과 검증"), PushResult.Num(), HandWrittenResult.Num());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqBenchmark_Suite_Int, "Private.LinqBenchmark.Suite.Int", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool LinqBenchmark_Suite_Int::RunTest(const FString& Parameters)
+{
+	LinqBenchmark::RunSuiteSizes<int>(*this, TEXT("int"));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqBenchmark_Suite_Payload, "Private.LinqBenchmark.Suite.Payload", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool LinqBenchmark_Suite_Payload::RunTest(const FString& Parameters)
+{
+	LinqBenchmark::RunSuiteSizes<LinqBenchmark::FPayload>(*this, TEXT("payload"));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqBenchmark_Suite_String, "Private.LinqBenchmark.Suite.String", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool LinqBenchmark_Suite_String::RunTest(const FString& Parameters)
+{
+	LinqBenchmark::RunSuiteSizes<FString>(*this, TEXT("FString"));
+	return true;
+}
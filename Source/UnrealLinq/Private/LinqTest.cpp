@@ -1,5 +1,9 @@
 #include "Misc/AutomationTest.h"
 #include "Linq.h"
+#include "LinqEngine.h"
+#include "LinqView.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_Primary_From, "Private.LinqTest.From", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
 
@@ -121,6 +125,34 @@ bool LinqTest_From_ToArray::RunTest(const FString& Parameters)
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_ToArray_Reserve, "Private.LinqTest.From_To_Array_Reserve", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_ToArray_Reserve::RunTest(const FString& Parameters)
+{
+	TArray<int> Array{2, 4, 1, 5, 2, 3};
+	auto Selected = From(Array) >> Select([](int X) { return X * 2; }) >> OrderBy([](int X) { return X; });
+	TestEqual(TEXT("MaxNum 전파 테스트"), Selected.MaxNum(), Array.Num());
+	TArray<int> Result = Selected >> ToArray();
+	TestEqual(TEXT("ToArray 한 번에 Reserve 테스트"), Result.Max(), Array.Num());
+
+	auto Filtered = From(Array) >> Where([](int X) { return X % 2 == 1; });
+	TestEqual(TEXT("Where 상한 테스트"), Filtered.MaxNum(), Array.Num());
+	Result = Filtered >> ToArray();
+	TestEqual(TEXT("Where ToArray 테스트"), Result.Num(), 3);
+
+	TArray<int> Large;
+	Large.SetNum(10000);
+	Result = From(Large) >> Where([](int X) { return X != 0; }) >> ToArray();
+	TestTrue(TEXT("Where ToArray 상한 Reserve 안 함 테스트"), Result.Max() < Large.Num());
+
+	TArray<int> Source{2, 4, 1, 5, 2, 3};
+	int* SourceData = Source.GetData();
+	Result = From(MoveTemp(Source)) >> ToArray();
+	TestTrue(TEXT("rvalue TArray 버퍼 재사용 테스트"), Result.GetData() == SourceData);
+	TestEqual(TEXT("rvalue TArray 버퍼 재사용 테스트"), Result.Num(), Array.Num());
+	return true;
+}
+
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_OrderBy_ThenBy, "Private.LinqTest.From_OrderBy_ThenBy", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
 
 bool LinqTest_From_OrderBy_ThenBy::RunTest(const FString& Parameters)
@@ -207,7 +239,20 @@ bool LinqTest_From_DistinctBy::RunTest(const FString& Parameters)
 		TestEqual(TEXT("Distinct 테스트"), Expect[i], Result[i]);
 	}
 
-	return true;
+	TArray<int> ExpectOrder{2, 3, 4, 1, 5};
+	Result = From(Array) >> DistinctBy([](int X){ return X; }, 5) >> ToArray();
+	for (int i = 0; i < ExpectOrder.Num(); ++i)
+	{
+		TestEqual(TEXT("Distinct 첫 등장 순서 테스트"), ExpectOrder[i], Result[i]);
+	}
+
+	int Calls = 0;
+	auto KeySelector = [&Calls](int X){ Calls += 1; return X; };
+	auto Streamed = From(Array) >> DistinctBy(KeySelector);
+	Streamed.MoveNext();
+	Streamed.MoveNext();
+	TestEqual(TEXT("Distinct 스트리밍 테스트"), Streamed.Current(), 3);
+	return TestEqual(TEXT("Distinct 스트리밍 테스트"), Calls, 3);
 }
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_ExceptBy, "Private.LinqTest.ExceptBy", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
@@ -238,11 +283,1109 @@ bool LinqTest_From_IntersectBy::RunTest(const FString& Parameters)
 	TArray<int> Intersect{7, 8, 1, 5};
 	TArray<int> Expect{1, 1, 5, 5, 7, 8};
 	
-	// TArray<int> Result = From(Array) >> IntersectBy(From(Intersect), [](int X){ return X; }) >> OrderBy([](int X){ return X; }) >> ToArray();
-	// for (int i = 0; i < Expect.Num(); ++i)
-	// {
-	// 	TestEqual("ExceptBy 테스트 ", Expect[i], Result[i]);
-	// }
+	TArray<int> Result = From(Array) >> IntersectBy(From(Intersect), [](int X){ return X; }) >> OrderBy([](int X){ return X; }) >> ToArray();
+	if (false == TestEqual(TEXT("IntersectBy 테스트"), Expect.Num(), Result.Num()))
+	{
+		return false;
+	}
+	for (int i = 0; i < Expect.Num(); ++i)
+	{
+		TestEqual(TEXT("IntersectBy 테스트"), Expect[i], Result[i]);
+	}
 
 	return true;
 }
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_UnionBy, "Private.LinqTest.UnionBy", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_UnionBy::RunTest(const FString& Parameters)
+{
+	TArray<int> First{2, 4, 2, 1};
+	TArray<int> Second{4, 5, 1, 6, 5};
+	TArray<int> Expect{2, 4, 1, 5, 6};
+
+	TArray<int> Result = From(First) >> UnionBy(From(Second), [](int X){ return X; }) >> ToArray();
+	if (false == TestEqual(TEXT("UnionBy 테스트"), Expect.Num(), Result.Num()))
+	{
+		return false;
+	}
+	for (int i = 0; i < Expect.Num(); ++i)
+	{
+		TestEqual(TEXT("UnionBy 테스트"), Expect[i], Result[i]);
+	}
+
+	int Index = 0;
+	auto Pulled = From(First) >> UnionBy(From(Second), [](int X){ return X; });
+	while (Pulled.MoveNext())
+	{
+		TestEqual(TEXT("UnionBy MoveNext 테스트"), Pulled.Current(), Expect[Index++]);
+	}
+	return TestEqual(TEXT("UnionBy MoveNext 테스트"), Index, Expect.Num());
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_AsParallel, "Private.LinqTest.AsParallel", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_AsParallel::RunTest(const FString& Parameters)
+{
+	TArray<int> Array;
+	Array.Reserve(10000);
+	for (int i = 0; i < 10000; ++i)
+	{
+		Array.Emplace(FMath::RandHelper(1000));
+	}
+
+	TArray<int> Expect = From(Array) >> Where([](int X) { return X % 3 == 0; }) >> Select([](int X) { return X * 2; }) >> ToArray();
+	TArray<int> Result = From(Array) >> AsParallel(256) >> Where([](int X) { return X % 3 == 0; }) >> Select([](int X) { return X * 2; }) >> ToArray();
+	if (false == TestEqual(TEXT("AsParallel Where >> Select 테스트"), Expect.Num(), Result.Num()))
+	{
+		return false;
+	}
+	for (int i = 0; i < Expect.Num(); ++i)
+	{
+		TestEqual(TEXT("AsParallel Where >> Select 순서 테스트"), Expect[i], Result[i]);
+	}
+
+	Result = From(Array) >> AsParallel(256) >> Select([](int X) { return X + 1; }) >> ToArray();
+	if (false == TestEqual(TEXT("AsParallel Select 테스트"), Array.Num(), Result.Num()))
+	{
+		return false;
+	}
+	for (int i = 0; i < Array.Num(); ++i)
+	{
+		TestEqual(TEXT("AsParallel Select 순서 테스트"), Array[i] + 1, Result[i]);
+	}
+
+	Expect = From(Array) >> Where([](int X) { return X < 10; }) >> OrderBy([](int X) { return X; }) >> ToArray();
+	Result = From(TArray<int>(Array)) >> AsParallel() >> Where([](int X) { return X < 10; }) >> OrderBy([](int X) { return X; }) >> ToArray();
+	if (false == TestEqual(TEXT("AsParallel 순차 실행 테스트"), Expect.Num(), Result.Num()))
+	{
+		return false;
+	}
+	for (int i = 0; i < Expect.Num(); ++i)
+	{
+		TestEqual(TEXT("AsParallel 순차 실행 테스트"), Expect[i], Result[i]);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_ForEach, "Private.LinqTest.ForEach", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_ForEach::RunTest(const FString& Parameters)
+{
+	TArray<int> Array{2, 4, 1, 5, 2, 3};
+	TArray<int> Expect{2, 10, 6};
+	TArray<int> Result;
+	From(Array) >> Where([](int X) { return X % 2 == 1; }) >> Select([](int X) { return X * 2; }) >> ForEach([&Result](int X) { Result.Emplace(X); });
+	if (false == TestEqual(TEXT("ForEach 테스트"), Expect.Num(), Result.Num()))
+	{
+		return false;
+	}
+	for (int i = 0; i < Expect.Num(); ++i)
+	{
+		TestEqual(TEXT("ForEach 테스트"), Expect[i], Result[i]);
+	}
+
+	auto Partial = From(Array) >> Where([](int X) { return X > 1; });
+	Partial.MoveNext();
+	Result = Partial >> ToArray();
+	TArray<int> ExpectRest{4, 5, 2, 3};
+	if (false == TestEqual(TEXT("MoveNext 이후 ForEach 이어서 순회 테스트"), ExpectRest.Num(), Result.Num()))
+	{
+		return false;
+	}
+	for (int i = 0; i < ExpectRest.Num(); ++i)
+	{
+		TestEqual(TEXT("MoveNext 이후 ForEach 이어서 순회 테스트"), ExpectRest[i], Result[i]);
+	}
+
+	// 배열 소스를 바로 ToArray 할 때도 이미 꺼낸 원소는 빼고, 소스는 끝까지 소비된다
+	auto Direct = From(Array);
+	Direct.MoveNext();
+	Direct.MoveNext();
+	if (false == TestEqual(TEXT("MoveNext 이후 배열 ToArray 테스트"), Direct >> ToArray(), TArray<int>(Array.GetData() + 2, Array.Num() - 2))) return false;
+	if (false == TestFalse(TEXT("배열 ToArray 이후 소진 테스트"), Direct.MoveNext())) return false;
+
+	int Sum = 0;
+	From(Array) >> OrderBy([](int X) { return X; }) >> ForEach([&Sum](int& X) { Sum += X; });
+	return TestEqual(TEXT("OrderBy >> ForEach 테스트"), Sum, 17);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_OrderBy_Keyed, "Private.LinqTest.OrderBy_Keyed", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_OrderBy_Keyed::RunTest(const FString& Parameters)
+{
+	typedef TTuple<float, int> FloatTuple;
+	TArray<FloatTuple> Array;
+	for (int i = 0; i < 1000; ++i)
+	{
+		Array.Emplace(FloatTuple{FMath::RandHelper(200) - 100.5f, FMath::RandHelper(8)});
+	}
+
+	int KeyCalls = 0;
+	int ThenCalls = 0;
+	TArray<FloatTuple> Result = From(Array)
+		>> OrderBy([&KeyCalls](const FloatTuple& X) { KeyCalls += 1; return X.Value; })
+		>> ThenBy([&ThenCalls](const FloatTuple& X) { ThenCalls += 1; return X.Key; })
+		>> ToArray();
+	TestEqual(TEXT("OrderBy 키 선택자 1회 호출 테스트"), KeyCalls, Array.Num());
+	TestEqual(TEXT("ThenBy 키 선택자 1회 호출 테스트"), ThenCalls, Array.Num());
+	for (int i = 1; i < Result.Num(); ++i)
+	{
+		TestTrue(TEXT("OrderBy >> ThenBy 음수 float 정렬 테스트"), Result[i - 1].Value < Result[i].Value || (Result[i - 1].Value == Result[i].Value && Result[i - 1].Key <= Result[i].Key));
+	}
+
+	// -0.0 과 +0.0 은 같은 키이므로 원소 수와 상관없이 원래 순서를 유지해야 한다
+	TArray<FloatTuple> Zeros;
+	for (int i = 0; i < 100; ++i)
+	{
+		Zeros.Emplace(FloatTuple{i % 2 == 0 ? -0.0f : 0.0f, i});
+	}
+	TArray<FloatTuple> ZeroResult = From(Zeros) >> OrderBy([](const FloatTuple& X) { return X.Key; }) >> ToArray();
+	for (int i = 0; i < ZeroResult.Num(); ++i)
+	{
+		if (false == TestEqual(TEXT("OrderBy -0.0 안정 정렬 테스트"), ZeroResult[i].Value, i)) return false;
+	}
+
+	typedef TTuple<int, int> IntTuple;
+	TArray<IntTuple> Stable;
+	for (int i = 0; i < 200; ++i)
+	{
+		Stable.Emplace(IntTuple{FMath::RandHelper(4), i});
+	}
+	TArray<IntTuple> StableResult = From(Stable) >> OrderBy([](const IntTuple& X) { return X.Key; }) >> ToArray();
+	for (int i = 1; i < StableResult.Num(); ++i)
+	{
+		if (StableResult[i - 1].Key == StableResult[i].Key)
+		{
+			TestTrue(TEXT("OrderBy 안정 정렬 테스트"), StableResult[i - 1].Value < StableResult[i].Value);
+		}
+	}
+
+	TArray<int> Numbers{3, 1, 2};
+	TArray<int> Expect{2, 4, 6};
+	TArray<int> Selected = From(Numbers) >> Select([](int X) { return X * 2; }) >> OrderBy([](int X) { return X; }) >> ToArray();
+	for (int i = 0; i < Expect.Num(); ++i)
+	{
+		TestEqual(TEXT("Select >> OrderBy 테스트"), Selected[i], Expect[i]);
+	}
+
+	TArray<FString> Names{TEXT("b"), TEXT("c"), TEXT("a")};
+	TArray<FString> Sorted = From(Names) >> OrderBy([](const FString& X) { return X; }) >> ToArray();
+	TestTrue(TEXT("비교 정렬 테스트"), Sorted[0] == TEXT("a") && Sorted[1] == TEXT("b") && Sorted[2] == TEXT("c"));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_TopBy, "Private.LinqTest.TopBy", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_TopBy::RunTest(const FString& Parameters)
+{
+	typedef TTuple<int, int> IntTuple;
+	TArray<IntTuple> Array;
+	for (int i = 0; i < 2000; ++i)
+	{
+		Array.Emplace(IntTuple{FMath::RandHelper(50), i});
+	}
+
+	TArray<IntTuple> Expect = From(Array) >> OrderBy([](const IntTuple& X) { return X.Key; }) >> ToArray();
+	TArray<IntTuple> Result = From(Array) >> TopBy(8, [](const IntTuple& X) { return X.Key; }) >> ToArray();
+	if (false == TestEqual(TEXT("TopBy 개수 테스트"), Result.Num(), 8))
+	{
+		return false;
+	}
+	for (int i = 0; i < Result.Num(); ++i)
+	{
+		TestEqual(TEXT("TopBy 안정 정렬 테스트"), Result[i].Key, Expect[i].Key);
+		TestEqual(TEXT("TopBy 안정 정렬 테스트"), Result[i].Value, Expect[i].Value);
+	}
+
+	Expect = From(Array) >> OrderBy([](const IntTuple& X) { return X.Key; }) >> ThenBy([](const IntTuple& X) { return -X.Value; }) >> ToArray();
+	Result = From(Array) >> TopBy(5, [](const IntTuple& X) { return X.Key; }) >> ThenBy([](const IntTuple& X) { return -X.Value; }) >> ToArray();
+	if (false == TestEqual(TEXT("TopBy >> ThenBy 개수 테스트"), Result.Num(), 5)) return false;
+	for (int i = 0; i < Result.Num(); ++i)
+	{
+		TestEqual(TEXT("TopBy >> ThenBy 테스트"), Result[i].Value, Expect[i].Value);
+	}
+
+	TArray<int> Numbers{3, 1, 2};
+	TArray<int> All = From(Numbers) >> Select([](int X) { return X * 10; }) >> TopBy(10, [](int X) { return X; }) >> ToArray();
+	TestEqual(TEXT("TopBy 개수 초과 테스트"), All.Num(), 3);
+	TestTrue(TEXT("TopBy 개수 초과 테스트"), All[0] == 10 && All[1] == 20 && All[2] == 30);
+
+	// 크기를 모르는 소스도 상위 K 개만 남긴다
+	TSet<int> Unknown;
+	for (int i = 10; i > 0; --i)
+	{
+		Unknown.Add(i);
+	}
+	TArray<int> Lowest = FromRange(Unknown.begin(), Unknown.end()) >> TopBy(2, [](int X) { return X; }) >> ToArray();
+	if (false == TestEqual(TEXT("크기 모르는 소스 TopBy 테스트"), Lowest, TArray<int>{1, 2})) return false;
+	auto Ranged = FromRange(Unknown.begin(), Unknown.end()) >> TopBy(3, [](int X) { return -X; }) >> ThenBy([](int X) { return X; });
+	if (false == TestEqual(TEXT("크기 모르는 소스 TopBy >> ThenBy 테스트"), Ranged >> ToArray(), TArray<int>{10, 9, 8})) return false;
+
+	TArray<int> Two = From(TArray<int>{5, 3, 4, 1, 2}) >> Select([](int X) { return X * 10; }) >> TopBy(2, [](int X) { return X; }) >> ToArray();
+	TestEqual(TEXT("Select >> TopBy 테스트"), Two.Num(), 2);
+	return TestTrue(TEXT("Select >> TopBy 테스트"), Two[0] == 10 && Two[1] == 20);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_GroupBy, "Private.LinqTest.GroupBy", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_GroupBy::RunTest(const FString& Parameters)
+{
+	TArray<int> Array{2, 4, 1, 5, 2, 3, 6, 9};
+	int Index = 0;
+	auto Groups = From(Array) >> GroupBy([](int X) { return X % 3; });
+	TArray<int> ExpectKeys{2, 1, 0};
+	TArray<int> ExpectNums{3, 2, 3};
+	while (Groups.MoveNext())
+	{
+		auto& Group = Groups.Current();
+		TestEqual(TEXT("GroupBy 키 순서 테스트"), Group.Key, ExpectKeys[Index]);
+		TestEqual(TEXT("GroupBy 개수 테스트"), Group.Num(), ExpectNums[Index]);
+		for (int i = 0; i < Group.Num(); ++i)
+		{
+			TestEqual(TEXT("GroupBy 원소 테스트"), Group[i] % 3, Group.Key);
+		}
+		Index += 1;
+	}
+	TestEqual(TEXT("GroupBy 그룹 수 테스트"), Index, ExpectKeys.Num());
+	TestTrue(TEXT("GroupBy 포인터 보관 테스트"), &(From(Array) >> GroupBy([](int X) { return X % 3; }) >> ToArray())[0][0] == &Array[0]);
+
+	TMap<int, int> Map = From(Array) >> ToMap([](int X) { return X; }, [](int X) { return X * 10; });
+	TestEqual(TEXT("ToMap 테스트"), Map.Num(), 7);
+	TestEqual(TEXT("ToMap 테스트"), Map[9], 90);
+
+	TSet<int> Set = From(Array) >> Select([](int X) { return X % 4; }) >> ToSet();
+	TestEqual(TEXT("ToSet 테스트"), Set.Num(), 4);
+	return TestTrue(TEXT("ToSet 테스트"), Set.Contains(3));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_Allocator, "Private.LinqTest.Allocator", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_Allocator::RunTest(const FString& Parameters)
+{
+	TArray<int> Array{2, 4, 1, 5, 2, 3};
+	TArray<int> Expect{1, 2, 3, 4, 5};
+	TArray<int, TInlineAllocator<16>> Result = From(Array)
+		>> DistinctBy<TInlineSetAllocator<16>>([](int X) { return X; })
+		>> OrderBy<TInlineAllocator<16>>([](int X) { return X; })
+		>> ToArray<TInlineAllocator<16>>();
+	if (false == TestEqual(TEXT("Allocator 지정 테스트"), Result.Num(), Expect.Num()))
+	{
+		return false;
+	}
+	for (int i = 0; i < Expect.Num(); ++i)
+	{
+		TestEqual(TEXT("Allocator 지정 테스트"), Result[i], Expect[i]);
+	}
+
+	auto Groups = From(Array) >> GroupBy<TInlineAllocator<8>, TInlineSetAllocator<8>>([](int X) { return X % 2; }) >> ToArray<TInlineAllocator<2>>();
+	TestEqual(TEXT("GroupBy Allocator 지정 테스트"), Groups.Num(), 2);
+	TestEqual(TEXT("GroupBy Allocator 지정 테스트"), Groups[0].Num(), 3);
+
+	TArray<int> Joined = From(Array) >> Join<TInlineAllocator<8>, TInlineSetAllocator<8>>(From(Expect), [](int X) { return X; }, [](int X) { return X; }, [](int L, int R) { return L + R; }) >> ToArray();
+	TestEqual(TEXT("Join Allocator 지정 테스트"), Joined, TArray<int>{4, 8, 2, 10, 4, 6});
+	auto Matched = From(Array) >> GroupJoin<TInlineAllocator<8>, TInlineSetAllocator<8>>(From(Expect), [](int X) { return X; }, [](int X) { return X; }, [](int X, auto& Group) { return Group.MaxNum(); }) >> Sum();
+	TestEqual(TEXT("GroupJoin Allocator 지정 테스트"), Matched, 6);
+
+	TArray<int, TInlineAllocator<16>> Top = From(Array) >> TopBy<TInlineAllocator<4>>(2, [](int X) { return X; }) >> ToArray<TInlineAllocator<16>>();
+	return TestTrue(TEXT("TopBy Allocator 지정 테스트"), Top.Num() == 2 && Top[0] == 1 && Top[1] == 2);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_Batched, "Private.LinqTest.Batched", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_Batched::RunTest(const FString& Parameters)
+{
+	TArray<float> Array;
+	for (int i = 0; i < 1000; ++i)
+	{
+		Array.Emplace(FMath::RandHelper(1000) * 0.5f);
+	}
+
+	TArray<float> Expect;
+	for (float X : Array)
+	{
+		if (X > 100.0f)
+		{
+			Expect.Emplace(X * 2.0f);
+		}
+	}
+
+	auto Pipeline = From(Array) >> Where([](float X) { return X > 100.0f; }) >> Select([](float X) { return X * 2.0f; });
+	TestTrue(TEXT("Batch 경로 선택 테스트"), Linq::TIsBatched<decltype(Pipeline)>::Value);
+	TArray<float> Result = Pipeline >> ToArray();
+	if (false == TestEqual(TEXT("Batch Where >> Select 테스트"), Result.Num(), Expect.Num()))
+	{
+		return false;
+	}
+	for (int i = 0; i < Expect.Num(); ++i)
+	{
+		TestEqual(TEXT("Batch Where >> Select 테스트"), Result[i], Expect[i]);
+	}
+
+	auto Partial = From(Array) >> Where([](float X) { return X > 100.0f; });
+	Partial.MoveNext();
+	TArray<float> Rest = Partial >> ToArray();
+	TestEqual(TEXT("MoveNext 이후 Batch 이어서 순회 테스트"), Rest.Num(), Expect.Num() - 1);
+
+	TArray<int> Empty = From(Array) >> Where([](float X) { return X < 0.0f; }) >> Select([](float X) { return int(X); }) >> ToArray();
+	return TestEqual(TEXT("Batch 빈 결과 테스트"), Empty.Num(), 0);
+}
+
+struct FTestRecord
+{
+public:
+	int Id = 0;
+	TArray<int> Values;
+};
+
+struct FTestNoDefault
+{
+public:
+	int Value;
+
+	explicit FTestNoDefault(int Value) : Value(Value)
+	{
+	}
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_Select_Reference, "Private.LinqTest.Select_Reference", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_Select_Reference::RunTest(const FString& Parameters)
+{
+	TArray<FTestRecord> Records;
+	Records.Emplace(FTestRecord{1, {1, 2, 3}});
+	Records.Emplace(FTestRecord{2, {4, 5}});
+
+	auto Members = From(Records) >> Select([](FTestRecord& X) -> TArray<int>& { return X.Values; });
+	int Index = 0;
+	while (Members.MoveNext())
+	{
+		TestTrue(TEXT("참조 Select 복사 없음 테스트"), &Members.Current() == &Records[Index++].Values);
+	}
+
+	int Sum = 0;
+	From(Records) >> Select([](const FTestRecord& X) -> const TArray<int>& { return X.Values; }) >> OrderBy([](const TArray<int>& X) { return X.Num(); }) >> ForEach([&Sum](const TArray<int>& X) { Sum += X[0]; });
+	TestEqual(TEXT("참조 Select >> OrderBy 테스트"), Sum, 5);
+
+	TArray<FTestNoDefault> NoDefault = From(Records) >> Select([](const FTestRecord& X) { return FTestNoDefault(X.Id); }) >> ToArray();
+	TestEqual(TEXT("기본 생성자 없는 Select 테스트"), NoDefault.Num(), 2);
+	TestEqual(TEXT("기본 생성자 없는 Select 테스트"), NoDefault[1].Value, 2);
+
+	TArray<TUniquePtr<int>> Unique = From(Records) >> Select([](const FTestRecord& X) { return MakeUnique<int>(X.Id); }) >> ToArray();
+	TestEqual(TEXT("이동 전용 Select 테스트"), *Unique[0], 1);
+
+	auto Pulled = From(Records) >> Select([](const FTestRecord& X) { return FTestNoDefault(X.Id * 10); });
+	Pulled.MoveNext();
+	Pulled.MoveNext();
+	return TestEqual(TEXT("기본 생성자 없는 Select MoveNext 테스트"), Pulled.Current().Value, 20);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_RandomAccess, "Private.LinqTest.RandomAccess", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_RandomAccess::RunTest(const FString& Parameters)
+{
+	TArray<int> Array = {1, 2, 3, 4, 5};
+
+	TArray<int> Reversed = From(Array) >> Select([](int X) { return X * 10; }) >> Reverse() >> ToArray();
+	if (false == TestEqual(TEXT("Select >> Reverse 테스트"), Reversed, TArray<int>{50, 40, 30, 20, 10})) return false;
+
+	TArray<int> Filtered = From(Array) >> Where([](int X) { return X % 2 == 1; }) >> Reverse() >> ToArray();
+	if (false == TestEqual(TEXT("Where >> Reverse 테스트"), Filtered, TArray<int>{5, 3, 1})) return false;
+
+	TArray<int> Empty;
+	if (false == TestEqual(TEXT("빈 배열 Reverse 테스트"), (From(Empty) >> Reverse() >> ToArray()).Num(), 0)) return false;
+
+	auto Enumerator = From(Array) >> Reverse();
+	Enumerator.MoveNext();
+	if (false == TestTrue(TEXT("Reverse 복사 없음 테스트"), &Enumerator.Current() == &Array[4])) return false;
+
+	if (false == TestEqual(TEXT("ElementAt 테스트"), (From(Array) >> ElementAt(2)).GetValue(), 3)) return false;
+	if (false == TestEqual(TEXT("Reverse >> ElementAt 테스트"), (From(Array) >> Reverse() >> ElementAt(1)).GetValue(), 4)) return false;
+	if (false == TestEqual(TEXT("Where >> ElementAt 테스트"), (From(Array) >> Where([](int X) { return X > 2; }) >> ElementAt(1)).GetValue(), 4)) return false;
+	if (false == TestFalse(TEXT("ElementAt 범위 밖 테스트"), (From(Array) >> ElementAt(5)).IsSet())) return false;
+
+	if (false == TestEqual(TEXT("Last 테스트"), (From(Array) >> Select([](int X) { return X + 1; }) >> Last()).GetValue(), 6)) return false;
+	if (false == TestEqual(TEXT("Where >> Last 테스트"), (From(Array) >> Where([](int X) { return X < 4; }) >> Last()).GetValue(), 3)) return false;
+	return TestFalse(TEXT("빈 배열 Last 테스트"), (From(Empty) >> Last()).IsSet());
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_Aggregate, "Private.LinqTest.Aggregate", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_Aggregate::RunTest(const FString& Parameters)
+{
+	TArray<int> Array;
+	for (int i = 1; i <= 1000; ++i)
+	{
+		Array.Emplace(i);
+	}
+	TArray<int> Empty;
+
+	if (false == TestTrue(TEXT("Any 테스트"), From(Array) >> Any())) return false;
+	if (false == TestFalse(TEXT("빈 배열 Any 테스트"), From(Empty) >> Any())) return false;
+	if (false == TestFalse(TEXT("Where >> Any 테스트"), From(Array) >> Where([](int X) { return X > 1000; }) >> Any())) return false;
+
+	int Evaluated = 0;
+	const bool HasEven = From(Array) >> Any([&Evaluated](int X) { ++Evaluated; return X % 2 == 0; });
+	if (false == TestTrue(TEXT("Any 조건 테스트"), HasEven)) return false;
+	if (false == TestEqual(TEXT("Any 조기 종료 테스트"), Evaluated, 2)) return false;
+
+	if (false == TestTrue(TEXT("All 테스트"), From(Array) >> All([](int X) { return X > 0; }))) return false;
+	if (false == TestFalse(TEXT("All 실패 테스트"), From(Array) >> All([](int X) { return X < 500; }))) return false;
+	if (false == TestTrue(TEXT("Contains 테스트"), From(Array) >> Contains(777))) return false;
+	if (false == TestFalse(TEXT("Contains 실패 테스트"), From(Array) >> Contains(1001))) return false;
+
+	if (false == TestEqual(TEXT("First 테스트"), (From(Array) >> Where([](int X) { return X > 10; }) >> First()).GetValue(), 11)) return false;
+	if (false == TestFalse(TEXT("빈 배열 First 테스트"), (From(Empty) >> First()).IsSet())) return false;
+
+	if (false == TestEqual(TEXT("Count 테스트"), From(Array) >> Count(), 1000)) return false;
+	if (false == TestEqual(TEXT("Where >> Count 테스트"), From(Array) >> Where([](int X) { return X % 3 == 0; }) >> Count(), 333)) return false;
+
+	if (false == TestEqual(TEXT("Sum 테스트"), From(Array) >> Sum(), 500500)) return false;
+	if (false == TestEqual(TEXT("Select >> Sum 테스트"), From(Array) >> Where([](int X) { return X <= 10; }) >> Select([](int X) { return X * 2; }) >> Sum(), 110)) return false;
+	if (false == TestEqual(TEXT("빈 배열 Sum 테스트"), From(Empty) >> Sum(), 0)) return false;
+
+	if (false == TestEqual(TEXT("Average 테스트"), (From(Array) >> Average()).GetValue(), 500.5)) return false;
+	if (false == TestFalse(TEXT("빈 배열 Average 테스트"), (From(Empty) >> Average()).IsSet())) return false;
+
+	TArray<int> Shuffled = {5, -3, 12, 7, 0, 12, -8, 4, 9};
+	if (false == TestEqual(TEXT("Min 테스트"), (From(Shuffled) >> Min()).GetValue(), -8)) return false;
+	if (false == TestEqual(TEXT("Max 테스트"), (From(Shuffled) >> Max()).GetValue(), 12)) return false;
+	if (false == TestEqual(TEXT("Where >> Max 테스트"), (From(Shuffled) >> Where([](int X) { return X < 10; }) >> Max()).GetValue(), 9)) return false;
+	if (false == TestFalse(TEXT("빈 배열 Min 테스트"), (From(Empty) >> Min()).IsSet())) return false;
+
+	TArray<FString> Names = {TEXT("b"), TEXT("c"), TEXT("a")};
+	if (false == TestEqual(TEXT("문자열 Min 테스트"), (From(Names) >> Min()).GetValue(), FString(TEXT("a")))) return false;
+	return TestEqual(TEXT("Select 문자열 Max 테스트"), (From(Names) >> Select([](const FString& X) { return X + TEXT("!"); }) >> Max()).GetValue(), FString(TEXT("c!")));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_TakeSkip, "Private.LinqTest.TakeSkip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_TakeSkip::RunTest(const FString& Parameters)
+{
+	TArray<int> Array = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+
+	if (false == TestEqual(TEXT("Take 테스트"), From(Array) >> Take(3) >> ToArray(), TArray<int>{1, 2, 3})) return false;
+	if (false == TestEqual(TEXT("Skip 테스트"), From(Array) >> Skip(7) >> ToArray(), TArray<int>{8, 9, 10})) return false;
+	if (false == TestEqual(TEXT("Skip >> Take 테스트"), From(Array) >> Skip(2) >> Take(2) >> ToArray(), TArray<int>{3, 4})) return false;
+	if (false == TestEqual(TEXT("Take 초과 테스트"), From(Array) >> Take(20) >> Count(), 10)) return false;
+	if (false == TestEqual(TEXT("Skip 초과 테스트"), From(Array) >> Skip(20) >> Count(), 0)) return false;
+	if (false == TestEqual(TEXT("Skip >> Reverse 테스트"), From(Array) >> Skip(8) >> Reverse() >> ToArray(), TArray<int>{10, 9})) return false;
+
+	int Evaluated = 0;
+	TArray<int> Evens = From(Array) >> Where([&Evaluated](int X) { ++Evaluated; return X % 2 == 0; }) >> Take(2) >> ToArray();
+	if (false == TestEqual(TEXT("Where >> Take 테스트"), Evens, TArray<int>{2, 4})) return false;
+	if (false == TestEqual(TEXT("Take 조기 종료 테스트"), Evaluated, 4)) return false;
+
+	Evaluated = 0;
+	auto Pulled = From(Array) >> Where([&Evaluated](int X) { ++Evaluated; return X > 5; }) >> Take(1);
+	while (Pulled.MoveNext())
+	{
+	}
+	if (false == TestEqual(TEXT("Take MoveNext 조기 종료 테스트"), Evaluated, 6)) return false;
+
+	TArray<int> Page = From(Array) >> OrderBy([](int X) { return -X; }) >> Skip(3) >> Take(3) >> ToArray();
+	if (false == TestEqual(TEXT("OrderBy >> Skip >> Take 테스트"), Page, TArray<int>{7, 6, 5})) return false;
+
+	auto Top = From(Array) >> OrderBy([](int X) { return X; }) >> Take(2);
+	if (false == TestEqual(TEXT("OrderBy >> Take TopCount 테스트"), Top.Enumerator.TopCount, 2)) return false;
+
+	// 크기를 모르는 Query<T>() 에서도 Skip + Take 만큼만 모으고, 합이 넘치면 포화시킨다
+	auto Paged = ::Query<int>() >> OrderBy([](int X) { return -X; }) >> Skip(3) >> Take(3);
+	if (false == TestEqual(TEXT("Query Skip >> Take TopCount 테스트"), Paged.Enumerator.Enumerator.TopCount, 6)) return false;
+	if (false == TestEqual(TEXT("Query Skip >> Take 결과 테스트"), Paged.Rebind(Array) >> ToArray(), TArray<int>{7, 6, 5})) return false;
+	auto Saturated = From(Array) >> OrderBy([](int X) { return X; }) >> Skip(5) >> Take(MAX_int32);
+	if (false == TestEqual(TEXT("Skip >> Take 포화 TopCount 테스트"), Saturated.Enumerator.Enumerator.TopCount, MAX_int32)) return false;
+	if (false == TestEqual(TEXT("Skip >> Take 포화 결과 테스트"), Saturated >> ToArray(), TArray<int>{6, 7, 8, 9, 10})) return false;
+
+	TArray<int> Batched = From(Array) >> Where([](int X) { return X > 2; }) >> Skip(1) >> Take(3) >> ToArray();
+	if (false == TestEqual(TEXT("Where >> Skip >> Take 배치 테스트"), Batched, TArray<int>{4, 5, 6})) return false;
+
+	if (false == TestEqual(TEXT("TakeWhile 테스트"), From(Array) >> TakeWhile([](int X) { return X < 4; }) >> ToArray(), TArray<int>{1, 2, 3})) return false;
+	if (false == TestEqual(TEXT("SkipWhile 테스트"), From(Array) >> SkipWhile([](int X) { return X < 8; }) >> ToArray(), TArray<int>{8, 9, 10})) return false;
+
+	TArray<int> Mixed = {1, 5, 2, 6};
+	auto Skipped = From(Mixed) >> SkipWhile([](int X) { return X < 3; });
+	TArray<int> Pulls;
+	while (Skipped.MoveNext())
+	{
+		Pulls.Emplace(Skipped.Current());
+	}
+	if (false == TestEqual(TEXT("SkipWhile MoveNext 테스트"), Pulls, TArray<int>{5, 2, 6})) return false;
+
+	Evaluated = 0;
+	From(Array) >> TakeWhile([&Evaluated](int X) { ++Evaluated; return X < 3; }) >> ForEach([](int) {});
+	return TestEqual(TEXT("TakeWhile 조기 종료 테스트"), Evaluated, 3);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_Instrumentation, "Private.LinqTest.Instrumentation", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_Instrumentation::RunTest(const FString& Parameters)
+{
+	TArray<int> Array = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+	auto Query = From(Array) >> Where([](int X) { return X % 2 == 0; }) >> OrderBy([](int X) { return -X; }) >> Take(2);
+	TArray<int> Result = Query >> ToArray();
+	if (false == TestEqual(TEXT("계측 결과 테스트"), Result, TArray<int>{10, 8})) return false;
+
+	TArray<Linq::FStageStats> Stats = Linq::CollectStats(Query);
+#if LINQ_INSTRUMENTATION
+	AddInfo(Linq::DescribeStats(Stats));
+	if (false == TestEqual(TEXT("계측 단계 수 테스트"), Stats.Num(), 4)) return false;
+	if (false == TestEqual(TEXT("Where pulled 테스트"), Stats[1].Pulled, (int64)10)) return false;
+	if (false == TestEqual(TEXT("Where yielded 테스트"), Stats[1].Yielded, (int64)5)) return false;
+	if (false == TestEqual(TEXT("Where predicate 테스트"), Stats[1].PredicateCalls, (int64)10)) return false;
+	if (false == TestEqual(TEXT("OrderBy pulled 테스트"), Stats[2].Pulled, (int64)5)) return false;
+	if (false == TestTrue(TEXT("OrderBy scratch 테스트"), Stats[2].ScratchBytes > 0)) return false;
+	return TestEqual(TEXT("Take yielded 테스트"), Stats[3].Yielded, (int64)2);
+#else
+	return TestEqual(TEXT("계측 비활성 테스트"), Stats.Num(), 0);
+#endif
+}
+
+template <typename T, typename = void>
+struct TCanFrom
+{
+	static constexpr bool Value = false;
+};
+
+template <typename T>
+struct TCanFrom<T, std::void_t<decltype(From(DeclVal<T>()))>>
+{
+	static constexpr bool Value = true;
+};
+
+template <typename TQuery, typename T, typename = void>
+struct TCanRebind
+{
+	static constexpr bool Value = false;
+};
+
+template <typename TQuery, typename T>
+struct TCanRebind<TQuery, T, std::void_t<decltype(DeclVal<TQuery&>().Rebind(DeclVal<T>()))>>
+{
+	static constexpr bool Value = true;
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_Sources, "Private.LinqTest.Sources", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_Sources::RunTest(const FString& Parameters)
+{
+	const TArray<int> Array = {1, 2, 3, 4, 5};
+	auto Constant = From(Array);
+	if (false == TestTrue(TEXT("const TArray 복사 없음 테스트"), Constant.Data == Array.GetData())) return false;
+	if (false == TestEqual(TEXT("const TArray 테스트"), Constant >> Where([](int X) { return X > 2; }) >> ToArray(), TArray<int>{3, 4, 5})) return false;
+	// const 원소의 멤버 참조는 const 로 남아야 한다
+	auto ConstMember = From(Array) >> Select([](const int& X) -> const int& { return X; });
+	if (false == TestTrue(TEXT("const 참조 Select 테스트"), std::is_same<decltype(ConstMember)::ElementType, const int>::value)) return false;
+	if (false == TestEqual(TEXT("const 참조 Select ToArray 테스트"), ConstMember >> Select([](const int& X) -> const int& { return X; }) >> ToArray(), Array)) return false;
+
+	TArray<int> Mutable = {1, 2, 3};
+	From(TArrayView<int>(Mutable)) >> ForEach([](int& X) { X *= 10; });
+	if (false == TestEqual(TEXT("TArrayView 쓰기 테스트"), Mutable, TArray<int>{10, 20, 30})) return false;
+	if (false == TestEqual(TEXT("TConstArrayView ElementAt 테스트"), (From(TConstArrayView<int>(Array)) >> Skip(1) >> ElementAt(2)).GetValue(), 4)) return false;
+
+	TSet<int> Set;
+	for (int X : Array)
+	{
+		Set.Add(X);
+	}
+	auto SetQuery = From(Set);
+	if (false == TestEqual(TEXT("TSet MaxNum 테스트"), SetQuery.MaxNum(), 5)) return false;
+	if (false == TestEqual(TEXT("TSet Sum 테스트"), SetQuery >> Sum(), 15)) return false;
+
+	TMap<int, FString> Map;
+	Map.Add(1, TEXT("One"));
+	Map.Add(2, TEXT("Two"));
+	Map.Add(3, TEXT("Three"));
+	if (false == TestEqual(TEXT("TMap 테스트"), From(Map) >> Where([](const auto& Pair) { return Pair.Key > 1; }) >> Count(), 2)) return false;
+	if (false == TestEqual(TEXT("FromKeys 테스트"), FromKeys(Map) >> Sum(), 6)) return false;
+	FromValues(Map) >> ForEach([](FString& Value) { Value += TEXT("!"); });
+	if (false == TestEqual(TEXT("FromValues 쓰기 테스트"), *Map.Find(2), FString(TEXT("Two!")))) return false;
+
+	TSparseArray<int> Sparse;
+	for (int X : Array)
+	{
+		Sparse.Add(X);
+	}
+	Sparse.RemoveAt(1);
+	Sparse.RemoveAt(3);
+	if (false == TestEqual(TEXT("TSparseArray 테스트"), From(Sparse) >> ToArray(), TArray<int>{1, 3, 5})) return false;
+	auto SparseQuery = From(Sparse) >> Take(2);
+	TArray<int> Pulls;
+	while (SparseQuery.MoveNext())
+	{
+		Pulls.Emplace(SparseQuery.Current());
+	}
+	if (false == TestEqual(TEXT("TSparseArray MoveNext 테스트"), Pulls, TArray<int>{1, 3})) return false;
+
+	int Raw[] = {4, 5, 6};
+	auto Pointers = FromRange(Raw, Raw + 3);
+	if (false == TestTrue(TEXT("포인터 범위 랜덤 접근 테스트"), Linq::TIsRandomAccess<decltype(Pointers)>::Value)) return false;
+	if (false == TestEqual(TEXT("포인터 범위 Last 테스트"), (Pointers >> Last()).GetValue(), 6)) return false;
+	if (false == TestEqual(TEXT("FromRange 컨테이너 테스트"), FromRange(Set) >> Count(), 5)) return false;
+
+	// 임시 컨테이너는 원소 하나짜리 배열로 바뀌지 않고 컴파일 에러가 나야 한다
+	if (false == TestFalse(TEXT("임시 TSet 거부 테스트"), TCanFrom<TSet<int>>::Value)) return false;
+	if (false == TestFalse(TEXT("임시 TMap 거부 테스트"), TCanFrom<TMap<int, FString>>::Value)) return false;
+	if (false == TestFalse(TEXT("임시 TSparseArray 거부 테스트"), TCanFrom<TSparseArray<int>>::Value)) return false;
+	if (false == TestTrue(TEXT("TSet 참조 허용 테스트"), TCanFrom<TSet<int>&>::Value)) return false;
+	return TestEqual(TEXT("임시 TArrayView 테스트"), From(TArrayView<int>(Mutable)) >> Count(), 3);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_Actors, "Private.LinqTest.Actors", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_Actors::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	for (int i = 0; i < 4; ++i)
+	{
+		AActor* Actor = World->SpawnActor<AActor>();
+		if (i % 2 == 0)
+		{
+			Actor->Tags.Add(TEXT("LinqTest"));
+		}
+	}
+
+	int Expected = 0;
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		++Expected;
+	}
+	bool Passed = TestEqual(TEXT("FromActors Count 테스트"), FromActors<AActor>(World) >> Count(), Expected)
+		&& TestEqual(TEXT("FromActors Where 테스트"), FromActors<AActor>(World) >> Where([](AActor* Actor) { return Actor->Tags.Contains(TEXT("LinqTest")); }) >> Count(), 2);
+
+	int Pulled = 0;
+	auto Query = FromActors<AActor>(World) >> Where([&Pulled](AActor* Actor) { ++Pulled; return true; }) >> Take(1);
+	while (Query.MoveNext())
+	{
+	}
+	Passed = Passed && TestEqual(TEXT("FromActors 조기 종료 테스트"), Pulled, 1);
+
+	// 시작된 이터레이터를 옮겨도 이어서 순회해야 한다
+	auto Started = FromActors<AActor>(World);
+	Started.MoveNext();
+	auto Moved = MoveTemp(Started);
+	Passed = Passed && TestEqual(TEXT("FromActors 이동 후 재개 테스트"), Moved >> Count(), Expected - 1);
+
+	int ExpectedObjects = 0;
+	for (TObjectIterator<AActor> It; It; ++It)
+	{
+		++ExpectedObjects;
+	}
+	Passed = Passed && TestEqual(TEXT("FromObjects 테스트"), FromObjects<AActor>() >> Count(), ExpectedObjects);
+
+	World->DestroyWorld(false);
+	return Passed;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_Fusion, "Private.LinqTest.Fusion", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_Fusion::RunTest(const FString& Parameters)
+{
+	TArray<int> Array = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+	int SecondCalls = 0;
+	auto Filtered = From(Array) >> Where([](int X) { return X % 2 == 0; }) >> Where([&SecondCalls](int X) { ++SecondCalls; return X > 4; });
+	if (false == TestTrue(TEXT("Where 융합 타입 테스트"), std::is_same<decltype(Filtered.Enumerator), Linq::TEnumeratorArray<int>>::value)) return false;
+	if (false == TestEqual(TEXT("Where 융합 결과 테스트"), Filtered >> ToArray(), TArray<int>{6, 8, 10})) return false;
+	if (false == TestEqual(TEXT("Where 융합 단락 평가 테스트"), SecondCalls, 5)) return false;
+
+	auto IsOdd = [](int X) { return X % 2 == 1; };
+	if (false == TestEqual(TEXT("Where 융합 lvalue 조건 테스트"), From(Array) >> Where(IsOdd) >> Where(IsOdd) >> Count(), 5)) return false;
+
+	auto Projected = From(Array) >> Select([](int X) { return X * 2; }) >> Select([](int X) { return X + 1; }) >> Select([](int X) { return float(X); });
+	if (false == TestTrue(TEXT("Select 융합 타입 테스트"), std::is_same<decltype(Projected.Enumerator), Linq::TEnumeratorArray<int>>::value)) return false;
+	if (false == TestEqual(TEXT("Select 융합 결과 테스트"), Projected >> Sum(), 120.0f)) return false;
+
+	TArray<TPair<int, FString>> Pairs = {TPair<int, FString>(1, TEXT("A")), TPair<int, FString>(2, TEXT("B"))};
+	auto References = From(Pairs) >> Select([](TPair<int, FString>& Pair) -> TPair<int, FString>& { return Pair; }) >> Select([](TPair<int, FString>& Pair) -> FString& { return Pair.Value; });
+	if (false == TestTrue(TEXT("참조 Select 융합 테스트"), decltype(References)::IsStableReference)) return false;
+	References >> ForEach([](FString& Value) { Value += TEXT("!"); });
+	if (false == TestEqual(TEXT("참조 Select 융합 쓰기 테스트"), Pairs[1].Value, FString(TEXT("B!")))) return false;
+
+	// The second projection returns a reference into the first projection's value, so the stages stay separate.
+	auto Copies = From(Pairs) >> Select([](const TPair<int, FString>& Pair) { return Pair; }) >> Select([](TPair<int, FString>& Pair) -> FString& { return Pair.Value; });
+	if (false == TestFalse(TEXT("값 참조 Select 비융합 테스트"), std::is_same<decltype(Copies.Enumerator), Linq::TEnumeratorArray<TPair<int, FString>>>::value)) return false;
+	if (false == TestEqual(TEXT("값 참조 Select 결과 테스트"), Copies >> ToArray(), TArray<FString>{TEXT("A!"), TEXT("B!")})) return false;
+
+	// 첫 투영 값을 가리키는 포인터도 값이 살아 있는 단계가 따로 있어야 한다
+	struct FBig
+	{
+		int Values[16];
+	};
+	auto Pointers = From(Array) >> Take(3) >> Select([](int X) { FBig Big = {}; Big.Values[0] = X; return Big; }) >> Select([](FBig& B) { return &B; });
+	if (false == TestTrue(TEXT("포인터 Select 비융합 테스트"), std::is_same<decltype(Pointers.Enumerator.Enumerator), decltype(From(Array) >> Take(3))>::value)) return false;
+	return TestEqual(TEXT("포인터 Select 결과 테스트"), Pointers >> Select([](FBig* B) { return B->Values[0]; }) >> ToArray(), TArray<int>{1, 2, 3});
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_Query, "Private.LinqTest.Query", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_Query::RunTest(const FString& Parameters)
+{
+	auto Query = ::Query<int>() >> Where([](int X) { return X % 2 == 0; }) >> OrderBy([](int X) { return -X; }) >> Skip(1) >> Take(2);
+
+	TArray<int> First = {1, 2, 3, 4, 5, 6, 7, 8};
+	if (false == TestEqual(TEXT("Query 첫 실행 테스트"), Query.Rebind(First) >> ToArray(), TArray<int>{6, 4})) return false;
+	const SIZE_T SortedBytes = Query.Enumerator.Enumerator.Sorted.GetAllocatedSize();
+
+	TArray<int> Second = {10, 20, 30, 40, 5};
+	if (false == TestEqual(TEXT("Query 재실행 테스트"), Query.Rebind(Second) >> ToArray(), TArray<int>{30, 20})) return false;
+	if (false == TestEqual(TEXT("Query 버퍼 재사용 테스트"), Query.Enumerator.Enumerator.Sorted.GetAllocatedSize(), SortedBytes)) return false;
+	TArray<int> None;
+	if (false == TestEqual(TEXT("Query 빈 입력 테스트"), Query.Rebind(None) >> Count(), 0)) return false;
+	if (false == TestFalse(TEXT("Query 임시 배열 Rebind 거부 테스트"), TCanRebind<decltype(Query), TArray<int>>::Value)) return false;
+	if (false == TestTrue(TEXT("Query 배열 Rebind 허용 테스트"), TCanRebind<decltype(Query), TArray<int>&>::Value)) return false;
+
+	// Rebind 뒤에 단계를 이어 붙여도 저장된 쿼리는 그대로 남아야 한다
+	if (false == TestEqual(TEXT("Query Rebind 뒤 Take 테스트"), Query.Rebind(First) >> Take(1) >> ToArray(), TArray<int>{6})) return false;
+	if (false == TestEqual(TEXT("Query Rebind 뒤 재실행 테스트"), Query.Rebind(First) >> ToArray(), TArray<int>{6, 4})) return false;
+	TArray<int> Budgeted;
+	auto Run = RunBudgeted(Query.Rebind(Second), Linq::FBudget::Elements(1), [&Budgeted](TArray<int>&& Result) { Budgeted = MoveTemp(Result); });
+	while (false == Run.Tick())
+	{
+	}
+	if (false == TestEqual(TEXT("Query RunBudgeted 테스트"), Budgeted, TArray<int>{30, 20})) return false;
+	if (false == TestEqual(TEXT("Query RunBudgeted 뒤 재실행 테스트"), Query.Rebind(First) >> ToArray(), TArray<int>{6, 4})) return false;
+
+	auto Groups = ::Query<const int>() >> Reverse() >> DistinctBy([](int X) { return X; }) >> GroupBy([](int X) { return X % 3; });
+	const TArray<int> Values = {1, 2, 3, 4, 1};
+	SIZE_T GroupBytes = 0;
+	for (int Run = 0; Run < 2; ++Run)
+	{
+		if (false == TestEqual(TEXT("Query GroupBy 재실행 테스트"), Groups.Rebind(Values) >> Count(), 3)) return false;
+		// 그룹마다의 원소 버퍼도 다음 실행에 다시 쓴다
+		const SIZE_T Bytes = Groups.Groups[0].Elements.Items.GetAllocatedSize();
+		if (Run == 1 && false == TestEqual(TEXT("Query GroupBy 버퍼 재사용 테스트"), Bytes, GroupBytes)) return false;
+		GroupBytes = Bytes;
+	}
+
+	// 예산 실행을 TopBy 수집 중간에 버리고 다시 Rebind 해도 이전 힙이 남지 않아야 한다
+	auto Top = ::Query<int>() >> TopBy(2, [](int X) { return X; });
+	TArray<int> Many = {9, 8, 7, 6, 5, 4, 3, 2, 1};
+	{
+		auto Abandoned = RunBudgeted(Top.Rebind(Many), Linq::FBudget::Elements(4), [](TArray<int>&& Result) {});
+		Abandoned.Tick();
+	}
+	TArray<int> Few = {7, 5, 6};
+	if (false == TestEqual(TEXT("Query TopBy 중단 후 Rebind 테스트"), Top.Rebind(Few) >> ToArray(), TArray<int>{5, 6})) return false;
+	auto While = ::Query<int>() >> TakeWhile([](int X) { return X < 3; }) >> SkipWhile([](int X) { return X < 2; });
+	TArray<int> Prefix = {1, 2, 3, 1};
+	if (false == TestEqual(TEXT("Query TakeWhile 첫 실행 테스트"), While.Rebind(Prefix) >> Sum(), 2)) return false;
+	return TestEqual(TEXT("Query TakeWhile 재실행 테스트"), While.Rebind(Prefix) >> Sum(), 2);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_Budgeted, "Private.LinqTest.Budgeted", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_Budgeted::RunTest(const FString& Parameters)
+{
+	TArray<int> Array = {5, 3, 9, 1, 7, 2, 8, 6, 4, 10};
+	int KeyCalls = 0;
+	TArray<int> Sorted;
+	auto Sort = RunBudgeted(From(Array) >> Where([](int X) { return X != 4; }) >> OrderBy([&KeyCalls](int X) { ++KeyCalls; return X; }), Linq::FBudget::Elements(3),
+		[&Sorted](TArray<int>&& Result) { Sorted = MoveTemp(Result); });
+	if (false == TestFalse(TEXT("예산 첫 Tick 테스트"), Sort.Tick())) return false;
+	if (false == TestEqual(TEXT("예산 정렬 수집 분할 테스트"), KeyCalls, 3)) return false;
+	int Ticks = 1;
+	while (false == Sort.Tick())
+	{
+		++Ticks;
+	}
+	if (false == TestEqual(TEXT("예산 정렬 결과 테스트"), Sorted, TArray<int>{1, 2, 3, 5, 6, 7, 8, 9, 10})) return false;
+	if (false == TestEqual(TEXT("예산 정렬 Tick 수 테스트"), Ticks, 6)) return false;
+	if (false == TestEqual(TEXT("예산 정렬 키 호출 테스트"), KeyCalls, 9)) return false;
+
+	TArray<int> Groups;
+	auto Grouping = RunBudgeted(From(Array) >> Reverse() >> GroupBy([](int X) { return X % 3; }) >> Select([](auto& Group) { return Group.Num(); }), Linq::FBudget::Elements(4),
+		[&Groups](TArray<int>&& Result) { Groups = MoveTemp(Result); });
+	while (false == Grouping.Tick())
+	{
+	}
+	if (false == TestEqual(TEXT("예산 Reverse GroupBy 테스트"), Groups, TArray<int>{4, 3, 3})) return false;
+
+	TArray<int> Large;
+	for (int i = 0; i < 100000; ++i)
+	{
+		Large.Emplace(FMath::RandHelper(1000));
+	}
+	int Total = -1;
+	auto TopRun = RunBudgeted(From(Large) >> TopBy(10, [](int X) { return X; }), Linq::FBudget::Microseconds(200), [&Total](TArray<int>&& Result) { Total = Result.Num(); });
+	Linq::IBudgetedRun& Timed = TopRun;
+	while (false == Timed.Tick())
+	{
+	}
+	if (false == TestEqual(TEXT("예산 시간 제한 테스트"), Total, 10)) return false;
+
+	// 걸러진 원소도 예산을 쓰므로 거의 다 거르는 Where 도 여러 Tick 에 나뉘어야 한다
+	int Found = -1;
+	auto Scan = RunBudgeted(From(Large) >> Where([](int X) { return X < 0; }), Linq::FBudget::Elements(1000), [&Found](TArray<int>&& Result) { Found = Result.Num(); });
+	int ScanTicks = 1;
+	while (false == Scan.Tick())
+	{
+		++ScanTicks;
+	}
+	if (false == TestEqual(TEXT("예산 Where 결과 테스트"), Found, 0)) return false;
+	if (false == TestTrue(TEXT("예산 Where 분할 테스트"), ScanTicks >= 100)) return false;
+
+	// 정렬의 radix pass 도 Tick 마다 하나씩 나뉜다
+	TArray<int> Radix;
+	auto RadixRun = RunBudgeted(From(Large) >> Take(10000) >> OrderBy([](int X) { return X; }), Linq::FBudget::Elements(10000), [&Radix](TArray<int>&& Result) { Radix = MoveTemp(Result); });
+	int RadixTicks = 1;
+	while (false == RadixRun.Tick())
+	{
+		++RadixTicks;
+	}
+	TArray<int> Expected(Large.GetData(), 10000);
+	Expected.Sort();
+	if (false == TestEqual(TEXT("예산 radix 정렬 결과 테스트"), Radix, Expected)) return false;
+	if (false == TestTrue(TEXT("예산 radix 정렬 분할 테스트"), RadixTicks >= 5)) return false;
+
+	// lvalue 쿼리와 콜백은 복사해 두고, 넘긴 쿼리는 그대로 쓸 수 있어야 한다
+	auto Evens = From(Array) >> Where([](int X) { return X % 2 == 0; });
+	int EvenNum = 0;
+	auto OnEvens = [&EvenNum](TArray<int>&& Result) { EvenNum = Result.Num(); };
+	auto EvenRun = RunBudgeted(Evens, Linq::FBudget::Elements(2), OnEvens);
+	if (false == TestFalse(TEXT("예산 콜백 복사 테스트"), std::is_reference<decltype(EvenRun.OnComplete)>::value)) return false;
+	while (false == EvenRun.Tick())
+	{
+	}
+	if (false == TestEqual(TEXT("예산 lvalue 쿼리 결과 테스트"), EvenNum, 5)) return false;
+	if (false == TestEqual(TEXT("예산 lvalue 쿼리 보존 테스트"), Evens >> Count(), 5)) return false;
+
+	// 배열을 가진 쿼리를 복사해 넘기면 원본이 사라져도 복사본이 자기 배열을 읽어야 한다
+	TArray<int> Owned;
+	auto OwnedRun = [&Owned]()
+	{
+		auto Source = From(TArray<int>{3, 1, 2}) >> Where([](int X) { return X != 1; });
+		return RunBudgeted(Source, Linq::FBudget::Elements(1), [&Owned](TArray<int>&& Result) { Owned = MoveTemp(Result); });
+	}();
+	while (false == OwnedRun.Tick())
+	{
+	}
+	if (false == TestEqual(TEXT("예산 소유 배열 복사 테스트"), Owned, TArray<int>{3, 2})) return false;
+
+	// 조건자 안의 쿼리와 완료 콜백의 쿼리는 실행 중인 예산을 쓰지 않는다
+	TSet<int> Values;
+	for (int i = 0; i < 100; ++i)
+	{
+		Values.Add(i);
+	}
+	TArray<int> Kept;
+	auto Nested = RunBudgeted(From(Array) >> Where([&Values](int X) { return (From(Values) >> Where([](int Y) { return Y % 10 == 0; }) >> Count()) == 10; }), Linq::FBudget::Elements(3),
+		[&Kept](TArray<int>&& Result) { Kept = MoveTemp(Result); });
+	while (false == Nested.Tick())
+	{
+	}
+	if (false == TestEqual(TEXT("예산 중첩 쿼리 테스트"), Kept, Array)) return false;
+	int MultipleNum = -1;
+	auto Callback = RunBudgeted(From(Array) >> Where([](int X) { return X % 2 == 0; }), Linq::FBudget::Elements(1),
+		[&Values, &MultipleNum](TArray<int>&& Result) { MultipleNum = From(Values) >> Where([](int X) { return X % 10 == 0; }) >> Count(); });
+	while (false == Callback.Tick())
+	{
+	}
+	return TestEqual(TEXT("예산 완료 콜백 쿼리 테스트"), MultipleNum, 10);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_Compose, "Private.LinqTest.Compose", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_Compose::RunTest(const FString& Parameters)
+{
+	TArray<int> First = {1, 2, 3};
+	TArray<int> Second = {4, 5};
+	auto Joined = From(First) >> Concat(From(Second));
+	if (false == TestTrue(TEXT("Concat 랜덤 접근 테스트"), Linq::TIsRandomAccess<decltype(Joined)>::Value)) return false;
+	if (false == TestEqual(TEXT("Concat MaxNum 테스트"), Joined.MaxNum(), 5)) return false;
+	if (false == TestEqual(TEXT("Concat 테스트"), Joined >> ToArray(), TArray<int>{1, 2, 3, 4, 5})) return false;
+	if (false == TestEqual(TEXT("Concat Reverse 테스트"), From(First) >> Concat(From(Second)) >> Reverse() >> ToArray(), TArray<int>{5, 4, 3, 2, 1})) return false;
+	if (false == TestEqual(TEXT("Concat Skip ElementAt 테스트"), (From(First) >> Concat(From(Second)) >> Skip(2) >> ElementAt(1)).GetValue(), 4)) return false;
+	auto Pulled = From(First) >> Concat(From(Second));
+	TArray<int> Pulls;
+	while (Pulled.MoveNext())
+	{
+		Pulls.Emplace(Pulled.Current());
+	}
+	if (false == TestEqual(TEXT("Concat MoveNext 테스트"), Pulls, TArray<int>{1, 2, 3, 4, 5})) return false;
+
+	TArray<FString> Names = {TEXT("A"), TEXT("B"), TEXT("C")};
+	auto Zipped = From(First) >> Zip(From(Names), [](int X, const FString& Name) { return Name + *FString::FromInt(X); });
+	if (false == TestEqual(TEXT("Zip MaxNum 테스트"), Zipped.MaxNum(), 3)) return false;
+	if (false == TestEqual(TEXT("Zip 테스트"), Zipped >> ToArray(), TArray<FString>{TEXT("A1"), TEXT("B2"), TEXT("C3")})) return false;
+	if (false == TestEqual(TEXT("Zip 짧은 쪽 테스트"), From(Second) >> Zip(From(First), [](int L, int R) { return L * R; }) >> ToArray(), TArray<int>{4, 10})) return false;
+	if (false == TestEqual(TEXT("Zip Last 테스트"), (From(First) >> Zip(From(Second), [](int L, int R) { return L + R; }) >> Last()).GetValue(), 7)) return false;
+
+	TArray<TArray<int>> Nested = {{1, 2}, {}, {3}, {4, 5, 6}};
+	auto Flattened = From(Nested) >> SelectMany([](TArray<int>& Inner) -> TArray<int>& { return Inner; });
+	if (false == TestEqual(TEXT("SelectMany MaxNum 테스트"), Flattened.MaxNum(), 6)) return false;
+	if (false == TestTrue(TEXT("SelectMany 참조 테스트"), decltype(Flattened)::IsStableReference)) return false;
+	if (false == TestEqual(TEXT("SelectMany 테스트"), Flattened >> ToArray(), TArray<int>{1, 2, 3, 4, 5, 6})) return false;
+	if (false == TestEqual(TEXT("SelectMany From 테스트"), From(Nested) >> SelectMany([](TArray<int>& Inner) { return From(Inner); }) >> Where([](int X) { return X % 2 == 0; }) >> ToArray(), TArray<int>{2, 4, 6})) return false;
+	if (false == TestEqual(TEXT("SelectMany 값 반환 테스트"), From(First) >> SelectMany([](int X) { return TArray<int>{X, X * 10}; }) >> Sum(), 66)) return false;
+	// 값으로 돌려주는 투영은 원소마다 한 번만 불려야 한다
+	int Calls = 0;
+	auto Copied = From(Nested) >> SelectMany([&Calls](TArray<int>& Inner) { ++Calls; return Inner; });
+	if (false == TestEqual(TEXT("SelectMany 값 MaxNum 테스트"), Copied.MaxNum(), 0)) return false;
+	if (false == TestEqual(TEXT("SelectMany 값 OrderBy 테스트"), Copied >> OrderBy([](int X) { return -X; }) >> Take(2) >> ToArray(), TArray<int>{6, 5})) return false;
+	if (false == TestEqual(TEXT("SelectMany 값 호출 수 테스트"), Calls, 4)) return false;
+	Calls = 0;
+	// 참조 투영의 크기 합은 처음 MaxNum 을 물을 때 한 번만 구한다
+	auto Referenced = From(Nested) >> SelectMany([&Calls](TArray<int>& Inner) -> TArray<int>& { ++Calls; return Inner; });
+	if (false == TestEqual(TEXT("SelectMany 생성 호출 수 테스트"), Calls, 0)) return false;
+	Referenced.MaxNum();
+	Referenced.MaxNum();
+	if (false == TestEqual(TEXT("SelectMany 참조 호출 수 테스트"), Calls, 4)) return false;
+	Calls = 0;
+	auto Unsized = From(Nested) >> SelectMany([&Calls](TArray<int>& Inner) -> TArray<int>& { ++Calls; return Inner; });
+	if (false == TestTrue(TEXT("SelectMany 첫 원소 테스트"), Unsized.MoveNext())) return false;
+	if (false == TestEqual(TEXT("SelectMany 남은 MaxNum 테스트"), Unsized.MaxNum(), 5)) return false;
+	while (Unsized.MoveNext())
+	{
+	}
+	if (false == TestEqual(TEXT("SelectMany 진행 중 MaxNum 호출 수 테스트"), Calls, 7)) return false;
+	if (false == TestEqual(TEXT("SelectMany Take 테스트"), From(Nested) >> SelectMany([](TArray<int>& Inner) -> TArray<int>& { return Inner; }) >> Take(4) >> ToArray(), TArray<int>{1, 2, 3, 4})) return false;
+
+	auto Stepped = From(Nested) >> SelectMany([](TArray<int>& Inner) -> TArray<int>& { return Inner; }) >> Skip(1);
+	Pulls.Reset();
+	while (Stepped.MoveNext())
+	{
+		Pulls.Emplace(Stepped.Current());
+	}
+	return TestEqual(TEXT("SelectMany MoveNext 테스트"), Pulls, TArray<int>{2, 3, 4, 5, 6});
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_Join, "Private.LinqTest.Join", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_Join::RunTest(const FString& Parameters)
+{
+	TArray<int> Owners = {1, 2, 3, 4};
+	TArray<int> Items = {10, 21, 11, 30, 12, 50};
+	auto ItemOwner = [](int Item) { return Item / 10; };
+	auto Pair = [](int Owner, int Item) { return Owner * 100 + Item; };
+	// 기본은 안쪽을 해시하고 바깥쪽 순서를 따른다
+	if (false == TestEqual(TEXT("Join 테스트"), From(Owners) >> Join(From(Items), [](int Owner) { return Owner; }, ItemOwner, Pair) >> ToArray(), TArray<int>{110, 111, 112, 221, 330})) return false;
+	if (false == TestEqual(TEXT("Join Take 테스트"), From(Owners) >> Join(From(Items), [](int Owner) { return Owner; }, ItemOwner, Pair) >> Take(2) >> ToArray(), TArray<int>{110, 111})) return false;
+
+	// 작은 쪽 해시를 켜면 더 작은 바깥쪽을 해시하고 안쪽 순서를 따른다
+	if (false == TestEqual(TEXT("Join 작은 쪽 해시 테스트"), From(Owners) >> Join(From(Items), [](int Owner) { return Owner; }, ItemOwner, Pair, true) >> ToArray(), TArray<int>{110, 221, 111, 330, 112})) return false;
+	TArray<int> Few = {3, 1};
+	if (false == TestEqual(TEXT("Join 큰 바깥쪽 테스트"), From(Items) >> Join(From(Few), ItemOwner, [](int Owner) { return Owner; }, [](int Item, int Owner) { return Owner * 100 + Item; }, true) >> ToArray(), TArray<int>{110, 111, 330, 112})) return false;
+
+	// 다대다 조인은 어느 입력 크기도 넘을 수 있으므로 크기를 모른다고 알린다
+	TArray<int> Ones = {1, 1, 1};
+	auto Product = From(Ones) >> Join(From(Ones), [](int X) { return X; }, [](int X) { return X; }, [](int L, int R) { return L + R; });
+	if (false == TestEqual(TEXT("Join MaxNum 테스트"), Product.MaxNum(), 0)) return false;
+	if (false == TestEqual(TEXT("Join 다대다 테스트"), Product >> Count(), 9)) return false;
+	if (false == TestEqual(TEXT("Join TopBy 테스트"), From(Ones) >> Join(From(Ones), [](int X) { return X; }, [](int X) { return X; }, [](int L, int R) { return L + R; }) >> TopBy(5, [](int X) { return X; }) >> Count(), 5)) return false;
+
+	auto Stepped = From(Owners) >> Where([](int Owner) { return Owner != 2; }) >> Join(From(Items) >> Select([](int Item) { return Item; }), [](int Owner) { return Owner; }, ItemOwner, Pair);
+	TArray<int> Pulls;
+	while (Stepped.MoveNext())
+	{
+		Pulls.Emplace(Stepped.Current());
+	}
+	if (false == TestEqual(TEXT("Join MoveNext 테스트"), Pulls, TArray<int>{110, 111, 112, 330})) return false;
+
+	auto Grouped = From(Owners) >> GroupJoin(From(Items), [](int Owner) { return Owner; }, ItemOwner, [](int Owner, auto& Group) { return Owner * 100 + Group.MaxNum(); });
+	if (false == TestEqual(TEXT("GroupJoin MaxNum 테스트"), Grouped.MaxNum(), 4)) return false;
+	if (false == TestEqual(TEXT("GroupJoin 테스트"), Grouped >> ToArray(), TArray<int>{103, 201, 301, 400})) return false;
+	if (false == TestEqual(TEXT("GroupJoin Sum 테스트"), From(Owners) >> GroupJoin(From(Items), [](int Owner) { return Owner; }, ItemOwner, [](int Owner, auto& Group) { return Group >> Sum(); }) >> ToArray(), TArray<int>{33, 21, 30, 0})) return false;
+	// 그룹은 선택자 호출 동안만 유효하므로 복사할 수 없고, 단계를 이어 붙이거나 ToArray 로 모아야 한다
+	if (false == TestFalse(TEXT("GroupJoin 그룹 복사 테스트"), std::is_copy_constructible<decltype(Grouped)::GroupType>::value)) return false;
+	if (false == TestEqual(TEXT("GroupJoin 그룹 Where 테스트"), From(Owners) >> GroupJoin(From(Items), [](int Owner) { return Owner; }, ItemOwner, [](int Owner, auto& Group) { return Group >> Where([](int Item) { return Item % 2 == 1; }) >> Count(); }) >> ToArray(), TArray<int>{1, 1, 0, 0})) return false;
+	TArray<TArray<int>> Collected = From(Owners) >> GroupJoin(From(Items), [](int Owner) { return Owner; }, ItemOwner, [](int Owner, auto& Group) { return Group >> ToArray(); }) >> ToArray();
+	return TestEqual(TEXT("GroupJoin 그룹 ToArray 테스트"), Collected.Num() == 4 ? Collected[1] : TArray<int>(), TArray<int>{21});
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_Columns, "Private.LinqTest.Columns", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_Columns::RunTest(const FString& Parameters)
+{
+	TArray<int> Ids = {1, 2, 3, 4, 5};
+	TArray<float> Health = {1.0f, 0.25f, 0.5f, 0.0f, 0.75f};
+	const TArray<int> Teams = {0, 1, 0, 1, 0};
+	auto Units = FromColumns(Ids, Health, TConstArrayView<int>(Teams));
+	typedef decltype(Units)::ElementType FUnitRow;
+	if (false == TestEqual(TEXT("Columns MaxNum 테스트"), Units.MaxNum(), 5)) return false;
+	if (false == TestEqual(TEXT("Columns Where Column 테스트"), Units >> Where([](const FUnitRow& Row) { return Row.Get<2>() == 0 && Row.Get<1>() < 0.8f; }) >> Column<0>() >> ToArray(), TArray<int>{3, 5})) return false;
+	if (false == TestEqual(TEXT("Columns Select 테스트"), FromColumns(Ids, Health) >> Select([](auto& Row) { return Row.template Get<0>() * 10; }) >> ToArray(), TArray<int>{10, 20, 30, 40, 50})) return false;
+	if (false == TestEqual(TEXT("Columns OrderBy 테스트"), FromColumns(Ids, Health) >> OrderBy([](const Linq::TColumnRow<int, float>& Row) { return Row.Get<1>(); }) >> Column<0>() >> ToArray(), TArray<int>{4, 2, 3, 5, 1})) return false;
+	if (false == TestEqual(TEXT("Columns ElementAt 테스트"), (FromColumns(Ids, Health) >> Skip(1) >> Column<1>() >> ElementAt(2)).GetValue(), 0.0f)) return false;
+
+	auto Direct = FromColumns(Ids, Health) >> Column<1>();
+	if (false == TestTrue(TEXT("Columns 배열 변환 테스트"), std::is_same<decltype(Direct), Linq::TEnumeratorArray<float>>::value)) return false;
+	if (false == TestEqual(TEXT("Columns Sum 테스트"), Direct >> Sum(), 2.5f)) return false;
+
+	FromColumns(Ids, Health) >> Where([](auto& Row) { return Row.template Get<1>() == 0.0f; }) >> Column<1>() >> ForEach([](float& Value) { Value = 1.0f; });
+	return TestEqual(TEXT("Columns 쓰기 테스트"), Health[3], 1.0f);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LinqTest_From_View, "Private.LinqTest.View", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool LinqTest_From_View::RunTest(const FString& Parameters)
+{
+	auto IsVisible = [](int X) { return X >= 0; };
+	auto Double = [](int X) { return X * 2; };
+	auto Threat = [](int X) { return X % 7; };
+
+	TArray<int> Units;
+	for (int i = 0; i < 200; ++i)
+	{
+		Units.Emplace(FMath::RandHelper(100) - 20);
+	}
+	auto Sorted = Query<int>() >> Where(IsVisible) >> Select(Double) >> OrderBy(Threat) >> ToView();
+	auto Visible = Query<int>() >> Where(IsVisible) >> ToView();
+	auto Counts = Query<int>() >> Where(IsVisible) >> GroupBy(Threat) >> ToView();
+	auto Top = Query<int>() >> Where(IsVisible) >> TopBy(10, Threat) >> ToView();
+	auto Taken = Query<int>() >> Where(IsVisible) >> OrderBy(Threat) >> Take(5) >> ToView();
+	Sorted.Build(Units);
+	Top.Build(Units);
+	Taken.Build(Units);
+	Visible.Build(Units);
+	Counts.Build(Units);
+
+	// 매 프레임 일부만 바뀌어도 전체를 다시 돌린 결과와 같아야 한다
+	for (int Frame = 0; Frame < 20; ++Frame)
+	{
+		for (int Change = 0; Change < 5; ++Change)
+		{
+			const int Id = FMath::RandHelper(Units.Num());
+			Units[Id] = FMath::RandHelper(100) - 20;
+			Sorted.Update(Id, Units[Id]);
+			Visible.Update(Id, Units[Id]);
+			Counts.Update(Id, Units[Id]);
+			Top.Update(Id, Units[Id]);
+			Taken.Update(Id, Units[Id]);
+		}
+		Units.Emplace(FMath::RandHelper(100));
+		Sorted.Add(Units.Num() - 1, Units.Last());
+		Visible.Add(Units.Num() - 1, Units.Last());
+		Counts.Add(Units.Num() - 1, Units.Last());
+		Top.Add(Units.Num() - 1, Units.Last());
+		Taken.Add(Units.Num() - 1, Units.Last());
+
+		if (false == TestEqual(TEXT("View OrderBy 테스트"), From(Sorted.Results()) >> ToArray(), From(Units) >> Where(IsVisible) >> Select(Double) >> OrderBy(Threat) >> ToArray())) return false;
+		if (false == TestEqual(TEXT("View TopBy 테스트"), From(Top.Results()) >> ToArray(), From(Units) >> Where(IsVisible) >> TopBy(10, Threat) >> ToArray())) return false;
+		if (false == TestEqual(TEXT("View OrderBy Take 테스트"), From(Taken.Results()) >> ToArray(), From(Units) >> Where(IsVisible) >> OrderBy(Threat) >> Take(5) >> ToArray())) return false;
+		if (false == TestEqual(TEXT("View Where 테스트"), Visible.Num(), From(Units) >> Where(IsVisible) >> Count())) return false;
+		if (false == TestEqual(TEXT("View Where 합계 테스트"), From(Visible.Results()) >> Sum(), From(Units) >> Where(IsVisible) >> Sum())) return false;
+		for (int Key = 0; Key < 7; ++Key)
+		{
+			if (false == TestEqual(TEXT("View GroupBy 테스트"), Counts.Num(Key), From(Units) >> Where(IsVisible) >> Where([&Threat, Key](int X) { return Threat(X) == Key; }) >> Count())) return false;
+		}
+	}
+
+	if (false == TestTrue(TEXT("View Remove 테스트"), Sorted.Remove(0) || Units[0] < 0)) return false;
+	if (false == TestFalse(TEXT("View Remove 없는 Id 테스트"), Sorted.Remove(0))) return false;
+	Units[0] = -1;
+	if (false == TestEqual(TEXT("View Remove 결과 테스트"), From(Sorted.Results()) >> ToArray(), From(Units) >> Where(IsVisible) >> Select(Double) >> OrderBy(Threat) >> ToArray())) return false;
+
+	// 걸러져 나가는 원소도 Update 한 번에 조건자를 한 번만 부른다
+	int Calls = 0;
+	TArray<int> Few = {3, 1, 2};
+	auto Counted = Query<int>() >> Where([&Calls](int X) { ++Calls; return X >= 0; }) >> OrderBy([](int X) { return X; }) >> ToView();
+	Counted.Build(Few);
+	Calls = 0;
+	Few[0] = -3;
+	Counted.Update(0, Few[0]);
+	Few[1] = 5;
+	Counted.Update(1, Few[1]);
+	if (false == TestEqual(TEXT("View Update 조건자 호출 수 테스트"), Calls, 2)) return false;
+	return TestEqual(TEXT("View Update 결과 테스트"), From(Counted.Results()) >> ToArray(), TArray<int>{2, 5});
+}
@@ -1,4 +1,13 @@
 ﻿#include "UnrealLinq.h"
+#include "Linq.h"
+
+#if LINQ_INSTRUMENTATION
+DEFINE_STAT(STAT_LinqPulled);
+DEFINE_STAT(STAT_LinqYielded);
+DEFINE_STAT(STAT_LinqPredicateCalls);
+DEFINE_STAT(STAT_LinqScratchBytes);
+DEFINE_STAT(STAT_LinqStageMilliseconds);
+#endif
 
 #define LOCTEXT_NAMESPACE "FUnrealLinqModule"
 
@@ -1,251 +1,409 @@
 #pragma once
-#include "Algo/StableSort.h"
+#include "Algo/Sort.h"
+#include "Async/ParallelFor.h"
+#include <tuple>
+
+// Per-stage instrumentation; enabled through PublicDefinitions in UnrealLinq.Build.cs.
+#ifndef LINQ_INSTRUMENTATION
+#define LINQ_INSTRUMENTATION 0
+#endif
+
+#if LINQ_INSTRUMENTATION
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_STATS_GROUP(TEXT("Linq"), STATGROUP_Linq, STATCAT_Advanced);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Elements Pulled"), STAT_LinqPulled, STATGROUP_Linq, UNREALLINQ_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Elements Yielded"), STAT_LinqYielded, STATGROUP_Linq, UNREALLINQ_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Predicate Calls"), STAT_LinqPredicateCalls, STATGROUP_Linq, UNREALLINQ_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Scratch Bytes"), STAT_LinqScratchBytes, STATGROUP_Linq, UNREALLINQ_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Stage Time (ms)"), STAT_LinqStageMilliseconds, STATGROUP_Linq, UNREALLINQ_API);
+
+#define LINQ_STAGE_COUNTER(Name) Linq::FStageCounter StageCounter{TEXT(Name)};
+#define LINQ_COUNT(Field, Value) (StageCounter.Stats.Field += (Value))
+#define LINQ_CALL(...) Linq::TimedCall(StageCounter, [&]() -> decltype(auto) { return (__VA_ARGS__); })
+#define LINQ_CYCLE_SCOPE() Linq::FCycleScope CycleScope(StageCounter.Stats.Cycles)
+#define LINQ_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE(Name)
+#else
+#define LINQ_STAGE_COUNTER(Name)
+#define LINQ_COUNT(Field, Value) ((void)0)
+#define LINQ_CALL(...) (__VA_ARGS__)
+#define LINQ_CYCLE_SCOPE()
+#define LINQ_TRACE_SCOPE(Name)
+#endif
 
 namespace Linq
 {
-	template <typename TElementType>
-	struct TEnumeratorArray
+	constexpr int BatchSize = 256;
+
+	struct FStageStats
 	{
 	public:
-		typedef TElementType ElementType;
-		TArray<ElementType> Container;
-		ElementType* Data = nullptr;
-		int Size = 0;
-		int Index = -1;
+		const TCHAR* Name = TEXT("");
+		int64 Pulled = 0;
+		int64 Yielded = 0;
+		int64 PredicateCalls = 0;
+		uint64 Cycles = 0;
+		int64 ScratchBytes = 0;
 
-		TEnumeratorArray(ElementType* Data, int Size) : Data(Data), Size(Size)
+		double Milliseconds() const
 		{
+			return Cycles * FPlatformTime::GetSecondsPerCycle64() * 1000.0;
 		}
 
-		TEnumeratorArray(TArray<ElementType>&& Array) : Container(MoveTemp(Array)), Data(Container.GetData()), Size(Container.Num())
+		FString ToString() const
 		{
+			return FString::Printf(TEXT("%-12s pulled %10lld  yielded %10lld  calls %10lld  %9.3f ms  scratch %10lld B"), Name, Pulled, Yielded, PredicateCalls, Milliseconds(), ScratchBytes);
 		}
+	};
 
-		bool MoveNext()
+	template <typename TEnumerator, typename = void>
+	struct THasUpstream
+	{
+		static constexpr bool Value = false;
+	};
+
+	template <typename TEnumerator>
+	struct THasUpstream<TEnumerator, std::void_t<decltype(DeclVal<TEnumerator&>().Enumerator)>>
+	{
+		static constexpr bool Value = true;
+	};
+
+#if LINQ_INSTRUMENTATION
+	// Every stage owns one; what it counted is flushed to the STAT counters when the stage dies.
+	// A move hands the counts over and a copy starts empty, so nothing is reported twice.
+	struct FStageCounter
+	{
+	public:
+		FStageStats Stats;
+
+		explicit FStageCounter(const TCHAR* Name)
 		{
-			if (Index < Size - 1)
-			{
-				Index += 1;
-				return true;
-			}
-			return false;
+			Stats.Name = Name;
 		}
 
-		ElementType& Current()
+		FStageCounter(FStageCounter&& Other) : Stats(Other.Stats)
 		{
-			return Data[Index];
+			Other.Reset();
 		}
 
-		template <typename TGenerator>
-		auto operator>>(TGenerator Generator)
+		FStageCounter(const FStageCounter& Other)
 		{
-			return Generator.Gen(*this);
+			Stats.Name = Other.Stats.Name;
 		}
-	};
 
-	template <typename TEnumerator, typename TPredicate>
-	struct TEnumeratorWhere
-	{
-	public:
-		typedef typename TEnumerator::ElementType ElementType;
-		TEnumerator Enumerator;
-		TPredicate&& Pred;
+		FStageCounter& operator=(FStageCounter&& Other)
+		{
+			Flush();
+			Stats = Other.Stats;
+			Other.Reset();
+			return *this;
+		}
 
-		TEnumeratorWhere(TEnumerator&& Enumerator, TPredicate&& Pred) : Enumerator(MoveTemp(Enumerator)), Pred(MoveTemp(Pred))
+		FStageCounter& operator=(const FStageCounter& Other)
 		{
+			Flush();
+			Stats.Name = Other.Stats.Name;
+			return *this;
 		}
 
-		bool MoveNext()
+		~FStageCounter()
 		{
-			while (Enumerator.MoveNext())
-			{
-				if (Pred(Enumerator.Current()))
-				{
-					return true;
-				}
-			}
-			return false;
+			Flush();
 		}
 
-		ElementType& Current()
+		void Reset()
 		{
-			return Enumerator.Current();
+			const TCHAR* Name = Stats.Name;
+			Stats = FStageStats();
+			Stats.Name = Name;
 		}
 
-		template <typename TGenerator>
-		auto operator>>(TGenerator Generator)
+		void Flush()
 		{
-			return Generator.Gen(*this);
+			INC_DWORD_STAT_BY(STAT_LinqPulled, Stats.Pulled);
+			INC_DWORD_STAT_BY(STAT_LinqYielded, Stats.Yielded);
+			INC_DWORD_STAT_BY(STAT_LinqPredicateCalls, Stats.PredicateCalls);
+			INC_DWORD_STAT_BY(STAT_LinqScratchBytes, Stats.ScratchBytes);
+			INC_FLOAT_STAT_BY(STAT_LinqStageMilliseconds, Stats.Milliseconds());
+			Reset();
 		}
 	};
 
-	template <typename TPredicate>
-	struct TGeneratorWhere
+	struct FCycleScope
 	{
 	public:
-		TPredicate&& Pred;
+		uint64& Cycles;
+		const uint64 Start;
 
-		TGeneratorWhere(TPredicate&& Pred) : Pred(MoveTemp(Pred))
+		FCycleScope(uint64& Cycles) : Cycles(Cycles), Start(FPlatformTime::Cycles64())
 		{
 		}
 
-		template <typename TEnumerator>
-		auto Gen(TEnumerator& Enumerator)
+		~FCycleScope()
 		{
-			return TEnumeratorWhere<TEnumerator, TPredicate>(MoveTemp(Enumerator), MoveTemp(Pred));
+			Cycles += FPlatformTime::Cycles64() - Start;
 		}
 	};
 
-	template <typename TPredicate>
-	struct Lambda : public Lambda<decltype(&TPredicate::operator())>
+	template <typename TCall>
+	decltype(auto) TimedCall(FStageCounter& Counter, TCall&& Call)
+	{
+		Counter.Stats.PredicateCalls += 1;
+		FCycleScope Scope(Counter.Stats.Cycles);
+		return Call();
+	}
+
+	template <typename TEnumerator>
+	void CollectStats(TEnumerator& Enumerator, TArray<FStageStats>& Stats)
+	{
+		if constexpr (THasUpstream<TEnumerator>::Value)
+		{
+			CollectStats(Enumerator.Enumerator, Stats);
+		}
+		Stats.Emplace(Enumerator.StageCounter.Stats);
+	}
+#endif
+
+	// Source first, terminal-side stage last; empty unless LINQ_INSTRUMENTATION is enabled.
+	template <typename TEnumerator>
+	TArray<FStageStats> CollectStats(TEnumerator& Enumerator)
+	{
+		TArray<FStageStats> Stats;
+#if LINQ_INSTRUMENTATION
+		CollectStats(Enumerator, Stats);
+#endif
+		return Stats;
+	}
+
+	inline FString DescribeStats(const TArray<FStageStats>& Stats)
+	{
+		FString Result;
+		for (const FStageStats& Stage : Stats)
+		{
+			Result += Stage.ToString();
+			Result += TEXT("\n");
+		}
+		return Result;
+	}
+
+	// Chains of Where/Select over an arithmetic array source can also hand out elements a batch at a time.
+	template <typename TEnumerator, typename = void>
+	struct TIsBatched
 	{
+		static constexpr bool Value = false;
 	};
 
-	template <typename TClass, typename TReturn, typename... Args>
-	struct Lambda<TReturn(TClass::*)(Args...) const>
+	template <typename TEnumerator>
+	struct TIsBatched<TEnumerator, std::void_t<decltype(TEnumerator::IsBatched)>>
 	{
-		typedef TReturn ReturnType;
+		static constexpr bool Value = TEnumerator::IsBatched;
 	};
 
-	template <typename TEnumerator, typename TPredicate>
-	struct TEnumeratorSelect
+	// Random-access enumerators know their exact remaining count (MaxNum) and can reach any remaining element
+	// with ElementAt(Offset) or drop elements with Advance(Count) without walking them.
+	template <typename TEnumerator, typename = void>
+	struct TIsRandomAccess
 	{
-		TEnumerator Enumerator;
-		TPredicate&& Pred;
-		typedef typename Lambda<TPredicate>::ReturnType ElementType;
-		ElementType CurrentValue;
+		static constexpr bool Value = false;
+	};
+
+	template <typename TEnumerator>
+	struct TIsRandomAccess<TEnumerator, std::void_t<decltype(TEnumerator::IsRandomAccess)>>
+	{
+		static constexpr bool Value = TEnumerator::IsRandomAccess;
+	};
+
+	// How much work one RunBudgeted tick may do; a zero limit is no limit.
+	struct FBudget
+	{
+	public:
+		double MaxMicroseconds = 0.0;
+		int MaxElements = 0;
 
-		TEnumeratorSelect(TEnumerator&& Enumerator, TPredicate&& Pred) : Enumerator(MoveTemp(Enumerator)), Pred(MoveTemp(Pred))
+		static FBudget Microseconds(double MaxMicroseconds)
 		{
+			FBudget Budget;
+			Budget.MaxMicroseconds = MaxMicroseconds;
+			return Budget;
 		}
 
-		bool MoveNext()
+		static FBudget Elements(int MaxElements)
 		{
-			while (Enumerator.MoveNext())
-			{
-				CurrentValue = Pred(Enumerator.Current());
-				return true;
-			}
-			return false;
+			FBudget Budget;
+			Budget.MaxElements = MaxElements;
+			return Budget;
 		}
+	};
 
-		ElementType& Current()
+	// Charged once per element a stage buffers, a Where rejects or the run yields; the clock is only read every
+	// ClockInterval elements.
+	struct FBudgetClock
+	{
+	public:
+		static constexpr int ClockInterval = 32;
+		double Deadline;
+		int RemainingElements;
+		int UntilClock = ClockInterval;
+		bool IsExhausted = false;
+
+		explicit FBudgetClock(const FBudget& Budget)
+			: Deadline(Budget.MaxMicroseconds > 0.0 ? FPlatformTime::Seconds() + Budget.MaxMicroseconds * 1e-6 : 0.0)
+			, RemainingElements(Budget.MaxElements > 0 ? Budget.MaxElements : MAX_int32)
 		{
-			return CurrentValue;
 		}
 
-		template <typename TGenerator>
-		auto operator>>(TGenerator Generator)
+		bool Consume()
 		{
-			return Generator.Gen(*this);
+			if (--RemainingElements <= 0)
+			{
+				IsExhausted = true;
+			}
+			else if (Deadline > 0.0 && --UntilClock <= 0)
+			{
+				UntilClock = ClockInterval;
+				IsExhausted = FPlatformTime::Seconds() >= Deadline;
+			}
+			return !IsExhausted;
+		}
+
+		// Charges a whole pass over Count elements, such as one radix pass of a sort, and reads the clock.
+		bool Consume(int Count)
+		{
+			RemainingElements -= Count;
+			UntilClock = ClockInterval;
+			IsExhausted = RemainingElements <= 0 || (Deadline > 0.0 && FPlatformTime::Seconds() >= Deadline);
+			return !IsExhausted;
 		}
 	};
 
-	template <typename TPredicate>
-	struct TGeneratorSelect
+	struct FUnlimitedBudget
 	{
 	public:
-		TPredicate&& Pred;
-
-		TGeneratorSelect(TPredicate&& Pred) : Pred(MoveTemp(Pred))
+		bool Consume()
 		{
+			return true;
 		}
 
-		template <typename TEnumerator>
-		auto Gen(TEnumerator& Enumerator)
+		bool Consume(int Count)
 		{
-			return TEnumeratorSelect<TEnumerator, TPredicate>(MoveTemp(Enumerator), MoveTemp(Pred));
+			return true;
 		}
 	};
 
-	struct TGeneratorToArray
+	template <typename TEnumerator, typename = void>
+	struct THasPrepare
 	{
-	public:
-		TGeneratorToArray()
+		static constexpr bool Value = false;
+	};
+
+	template <typename TEnumerator>
+	struct THasPrepare<TEnumerator, std::void_t<decltype(DeclVal<TEnumerator&>().Prepare(DeclVal<FUnlimitedBudget&>()))>>
+	{
+		static constexpr bool Value = true;
+	};
+
+	// Runs the buffering work of a pipeline (sort, Reverse, GroupBy and key set gathers) within Budget, resuming
+	// where the last call stopped. True once only streaming work is left; stages that buffer nothing defer upstream.
+	template <typename TEnumerator, typename TBudget>
+	bool Prepare(TEnumerator& Enumerator, TBudget& Budget)
+	{
+		if constexpr (THasPrepare<TEnumerator>::Value)
 		{
+			return Enumerator.Prepare(Budget);
 		}
-
-		template <typename TEnumerator>
-		auto Gen(TEnumerator& Enumerator)
+		else if constexpr (THasUpstream<TEnumerator>::Value)
 		{
-			TArray<typename TEnumerator::ElementType> Array;
-			while (Enumerator.MoveNext())
-			{
-				Array.Emplace(Enumerator.Current());
-			}
-			return Array;
+			return Linq::Prepare(Enumerator.Enumerator, Budget);
+		}
+		else
+		{
+			return true;
 		}
+	}
+
+	template <typename TEnumerator, typename = void>
+	struct THasBudgetClock
+	{
+		static constexpr bool Value = false;
 	};
 
-	struct IEnumeratorSort
+	template <typename TEnumerator>
+	struct THasBudgetClock<TEnumerator, std::void_t<decltype(DeclVal<TEnumerator&>().BudgetClock)>>
 	{
+		static constexpr bool Value = true;
 	};
 
-	template <typename TEnumerator, typename TPredicate, bool IsAscending>
-	struct TEnumeratorOrderBy : public IEnumeratorSort
+	// Hands a RunBudgeted tick's clock to the Where stages of its own pipeline, or takes it back with nullptr. Queries
+	// run from predicates, SelectMany inners and the completion callback are separate pipelines and never see it.
+	template <typename TEnumerator>
+	void SetBudgetClock(TEnumerator& Enumerator, FBudgetClock* Clock)
+	{
+		if constexpr (THasBudgetClock<TEnumerator>::Value)
+		{
+			Enumerator.BudgetClock = Clock;
+		}
+		if constexpr (THasUpstream<TEnumerator>::Value)
+		{
+			SetBudgetClock(Enumerator.Enumerator, Clock);
+		}
+	}
+
+	// What Rebind hands back: the stored pipeline by reference. Stages chained after it and RunBudgeted wrap the
+	// handle instead of moving the query's own stages and buffers out, so the query can be rebound again.
+	template <typename TEnumerator>
+	struct TEnumeratorRef
 	{
 	public:
 		typedef typename TEnumerator::ElementType ElementType;
-		TEnumerator Enumerator;
-		TPredicate&& Pred;
-		TArray<ElementType*> Sorted;
-		int64 Index = -1;
+		TEnumerator& Enumerator;
+		LINQ_STAGE_COUNTER("Rebind")
 
-		TEnumeratorOrderBy(TEnumerator&& Enumerator, TPredicate&& Pred) : Enumerator(MoveTemp(Enumerator)), Pred(MoveTemp(Pred))
+		explicit TEnumeratorRef(TEnumerator& Enumerator) : Enumerator(Enumerator)
 		{
-			if (std::is_convertible<TEnumerator, IEnumeratorSort>::value)
-			{
-				verify(true);
-			}
 		}
 
-		bool Compare(const ElementType& L, const ElementType& R)
+		bool MoveNext()
 		{
-			if (IsAscending)
-			{
-				return Pred(L) < Pred(R);
-			}
-			else
-			{
-				return Pred(R) < Pred(L);
-			}
+			return Enumerator.MoveNext();
 		}
 
-		bool ForwardMoveNext()
+		ElementType& Current()
 		{
-			return Enumerator.MoveNext();
+			return Enumerator.Current();
 		}
 
-		ElementType& ForwardCurrent()
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
 		{
-			return Enumerator.Current();
+			return Enumerator.ForEach(Forward<TSink>(Sink));
 		}
 
-		bool MoveNext()
+		static constexpr bool IsExactNum = TEnumerator::IsExactNum;
+		static constexpr bool IsStableReference = TEnumerator::IsStableReference;
+
+		int MaxNum() const
 		{
-			if (Index == -1)
-			{
-				while (Enumerator.MoveNext())
-				{
-					Sorted.Emplace(&Enumerator.Current());
-				}
-				Algo::StableSort(Sorted, [this](ElementType* L, ElementType* R)
-				{
-					return this->Compare(*L, *R);
-				});
-			}
+			return Enumerator.MaxNum();
+		}
 
-			if (Index < Sorted.Num() - 1)
-			{
-				Index += 1;
-				return true;
-			}
-			return false;
+		static constexpr bool IsRandomAccess = TIsRandomAccess<TEnumerator>::Value;
+
+		decltype(auto) ElementAt(int Offset)
+		{
+			return Enumerator.ElementAt(Offset);
 		}
 
-		ElementType& Current()
+		void Advance(int Count)
+		{
+			Enumerator.Advance(Count);
+		}
+
+		static constexpr bool IsBatched = TIsBatched<TEnumerator>::Value;
+
+		const ElementType* NextBatch(ElementType* Scratch, int& Num)
 		{
-			return *Sorted[Index];
+			return Enumerator.NextBatch(Scratch, Num);
 		}
 
 		template <typename TGenerator>
@@ -255,70 +413,88 @@ namespace Linq
 		}
 	};
 
-	template <typename TEnumerator, typename TPredicate, bool IsAscending>
-	struct TEnumeratorThenBy : public IEnumeratorSort
+	template <typename TElementType>
+	struct TEnumeratorArray
 	{
 	public:
-		typedef typename TEnumerator::ElementType ElementType;
-		TEnumerator Enumerator;
-		TPredicate&& Pred;
-		TArray<ElementType*> Sorted;
-		int64 Index = -1;
+		typedef TElementType ElementType;
+		TArray<std::remove_const_t<ElementType>> Container;
+		ElementType* Data = nullptr;
+		int Size = 0;
+		int Index = -1;
+		LINQ_STAGE_COUNTER("From")
 
-		TEnumeratorThenBy(TEnumerator&& Enumerator, TPredicate&& Pred) : Enumerator(MoveTemp(Enumerator)), Pred(MoveTemp(Pred))
+		TEnumeratorArray(ElementType* Data, int Size) : Data(Data), Size(Size)
 		{
-			if (!std::is_convertible<TEnumerator, IEnumeratorSort>::value)
-			{
-				verify(true);
-			}
 		}
 
-		bool Compare(const ElementType& L, const ElementType& R)
+		TEnumeratorArray(TArray<std::remove_const_t<ElementType>>&& Array) : Container(MoveTemp(Array)), Data(Container.GetData()), Size(Container.Num())
 		{
-			if (Enumerator.Compare(L, R))
-			{
-				return true;
-			}
-			if (Enumerator.Compare(R, L))
-			{
-				return false;
-			}
-			if (IsAscending)
-			{
-				return Pred(L) < Pred(R);
-			}
-			else
-			{
-				return Pred(R) < Pred(L);
-			}
 		}
 
-		bool ForwardMoveNext()
+		// A source that owns its array keeps Data inside Container, so copies and moves point it at their own.
+		TEnumeratorArray(const TEnumeratorArray& Other) : Container(Other.Container), Data(Other.IsOwned() ? Container.GetData() : Other.Data), Size(Other.Size), Index(Other.Index)
 		{
-			return Enumerator.MoveNext();
 		}
 
-		ElementType& ForwardCurrent()
+		TEnumeratorArray(TEnumeratorArray&& Other) : Data(Other.Data), Size(Other.Size), Index(Other.Index)
+#if LINQ_INSTRUMENTATION
+			, StageCounter(MoveTemp(Other.StageCounter))
+#endif
 		{
-			return Enumerator.Current();
+			if (Other.IsOwned())
+			{
+				Container = MoveTemp(Other.Container);
+				Data = Container.GetData();
+				Other.Data = nullptr;
+				Other.Size = 0;
+			}
 		}
 
-		bool MoveNext()
+		TEnumeratorArray& operator=(const TEnumeratorArray& Other)
+		{
+			if (this != &Other)
+			{
+				Container = Other.Container;
+				Data = Other.IsOwned() ? Container.GetData() : Other.Data;
+				Size = Other.Size;
+				Index = Other.Index;
+			}
+			return *this;
+		}
+
+		TEnumeratorArray& operator=(TEnumeratorArray&& Other)
 		{
-			if (Index == -1)
+			if (this != &Other)
 			{
-				while (Enumerator.ForwardMoveNext())
+				Data = Other.Data;
+				Size = Other.Size;
+				Index = Other.Index;
+				if (Other.IsOwned())
 				{
-					Sorted.Emplace(&Enumerator.ForwardCurrent());
+					Container = MoveTemp(Other.Container);
+					Data = Container.GetData();
+					Other.Data = nullptr;
+					Other.Size = 0;
 				}
-				Algo::StableSort(Sorted, [this](ElementType* L, ElementType* R)
+				else
 				{
-					return this->Compare(*L, *R);
-				});
+					Container.Empty();
+				}
 			}
+			return *this;
+		}
 
-			if (Index < Sorted.Num() - 1)
+		bool IsOwned() const
+		{
+			return Data != nullptr && Data == Container.GetData();
+		}
+
+		bool MoveNext()
+		{
+			if (Index < Size - 1)
 			{
+				LINQ_COUNT(Yielded, 1);
 				Index += 1;
 				return true;
 			}
@@ -327,76 +503,120 @@ namespace Linq
 
 		ElementType& Current()
 		{
-			return *Sorted[Index];
+			return Data[Index];
 		}
 
-		template <typename TGenerator>
-		auto operator>>(TGenerator Generator)
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
 		{
-			return Generator.Gen(*this);
+			ElementType* const Begin = Data;
+			const int End = Size;
+			for (int Cursor = Index + 1; Cursor < End; ++Cursor)
+			{
+				if (!Sink(Begin[Cursor]))
+				{
+					LINQ_COUNT(Yielded, Cursor - Index);
+					Index = Cursor;
+					return false;
+				}
+			}
+			LINQ_COUNT(Yielded, End - 1 - Index);
+			Index = End - 1;
+			return true;
 		}
-	};
 
-	template <typename TPredicate>
-	struct TGeneratorOrderBy
-	{
-	public:
-		TPredicate&& Pred;
+		static constexpr bool IsExactNum = true;
+		static constexpr bool IsStableReference = true;
 
-		TGeneratorOrderBy(TPredicate&& Pred) : Pred(MoveTemp(Pred))
+		int MaxNum() const
 		{
+			return Size - Index - 1;
 		}
 
-		template <typename TEnumerator>
-		auto Gen(TEnumerator& Enumerator)
+		bool IsOwnedUntouched() const
 		{
-			return TEnumeratorOrderBy<TEnumerator, TPredicate, true>(MoveTemp(Enumerator), MoveTemp(Pred));
+			return Index == -1 && Container.Num() == Size && Data == Container.GetData();
 		}
-	};
 
-	template <typename TPredicate>
-	struct TGeneratorThenBy
-	{
-	public:
-		TPredicate&& Pred;
+		static constexpr bool IsRandomAccess = true;
 
-		TGeneratorThenBy(TPredicate&& Pred) : Pred(MoveTemp(Pred))
+		ElementType& ElementAt(int Offset)
 		{
+			return Data[Index + 1 + Offset];
 		}
 
-		template <typename TEnumerator>
-		auto Gen(TEnumerator& Enumerator)
+		void Advance(int Count)
 		{
-			return TEnumeratorThenBy<TEnumerator, TPredicate, true>(MoveTemp(Enumerator), MoveTemp(Pred));
+			Index = FMath::Min(Index + Count, Size - 1);
 		}
-	};
 
-	template <typename TEnumerator>
-	struct TEnumeratorReverse
-	{
-		TEnumerator Enumerator;
-		typedef typename TEnumerator::ElementType ElementType;
-		TArray<ElementType*> Reversed;
-		int Index = -1;
+		static constexpr bool IsBatched = std::is_arithmetic<ElementType>::value && !std::is_const<ElementType>::value;
 
-		TEnumeratorReverse(TEnumerator&& Enumerator) : Enumerator(Enumerator)
+		const ElementType* NextBatch(ElementType* Scratch, int& Num)
 		{
+			const int Start = Index + 1;
+			Num = FMath::Min(BatchSize, Size - Start);
+			LINQ_COUNT(Yielded, Num);
+			Index += Num;
+			return Data + Start;
 		}
 
-		bool MoveNext()
+		// Points a Query<T>() pipeline at new data; each stage downstream resets its cursor and keeps its buffers.
+		template <typename TSource>
+		TEnumeratorRef<TEnumeratorArray> Rebind(TSource& Source)
+		{
+			static_assert(std::is_convertible<decltype(Source.GetData()), ElementType*>::value, "Rebinding to a const array needs a Query<const T>() pipeline");
+			Data = Source.GetData();
+			Size = Source.Num();
+			Index = -1;
+			return TEnumeratorRef<TEnumeratorArray>(*this);
+		}
+
+		// A temporary would be gone before the pipeline runs.
+		template <typename TSource>
+		void Rebind(TSource&& Source) = delete;
+
+		template <typename TGenerator>
+		auto operator>>(TGenerator Generator)
+		{
+			return Generator.Gen(*this);
+		}
+	};
+
+	// Walks any container with begin()/end() (TSet, TMap, TSparseArray, ...) in place.
+	// IsKnownNum is set when the container can report its element count up front.
+	template <typename TIterator, bool IsKnownNum>
+	struct TEnumeratorRange
+	{
+	public:
+		typedef std::remove_reference_t<decltype(*DeclVal<TIterator&>())> ElementType;
+		TIterator It;
+		TIterator End;
+		int Remaining;
+		bool IsStarted = false;
+		LINQ_STAGE_COUNTER("From")
+
+		TEnumeratorRange(TIterator It, TIterator End, int Num) : It(MoveTemp(It)), End(MoveTemp(End)), Remaining(Num)
+		{
+		}
+
+		// The iterator stays on the element last handed out, so step past it before resuming.
+		void Resume()
 		{
-			if (Index == -1)
+			if (IsStarted && It != End)
 			{
-				while (Enumerator.MoveNext())
-				{
-					Reversed.Emplace(&Enumerator.Current());
-				}
-				Index = Reversed.Num() - 1;
+				++It;
 			}
+			IsStarted = true;
+		}
 
-			if (Index > -1)
+		bool MoveNext()
+		{
+			Resume();
+			if (It != End)
 			{
-				Index -= 1;
+				LINQ_COUNT(Yielded, 1);
+				Remaining -= 1;
 				return true;
 			}
 			return false;
@@ -404,7 +624,30 @@ namespace Linq
 
 		ElementType& Current()
 		{
-			return *Reversed[Index];
+			return *It;
+		}
+
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			for (Resume(); It != End; ++It)
+			{
+				LINQ_COUNT(Yielded, 1);
+				Remaining -= 1;
+				if (!Sink(*It))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		static constexpr bool IsExactNum = IsKnownNum;
+		static constexpr bool IsStableReference = true;
+
+		int MaxNum() const
+		{
+			return IsKnownNum ? FMath::Max(Remaining, 0) : 0;
 		}
 
 		template <typename TGenerator>
@@ -414,55 +657,123 @@ namespace Linq
 		}
 	};
 
-	struct TGeneratorReverse
+	// Drives a UE-style iterator (operator bool, operator++, operator* returning a pointer) such as
+	// TObjectIterator or TActorIterator. Those iterators are not movable, so the enumerator keeps the
+	// constructor arguments and builds the iterator on the heap the first time it is pulled; moving the
+	// enumerator then hands the started iterator over instead of copying it.
+	template <typename TIterator, typename... TArgs>
+	struct TEnumeratorIterator
 	{
 	public:
-		TGeneratorReverse()
+		typedef std::decay_t<decltype(*DeclVal<TIterator&>())> ElementType;
+		std::tuple<TArgs...> Args;
+		TUniquePtr<TIterator> Iterator;
+		ElementType Object = nullptr;
+		LINQ_STAGE_COUNTER("From")
+
+		explicit TEnumeratorIterator(TArgs... Args) : Args(MoveTemp(Args)...)
 		{
 		}
 
-		template <typename TEnumerator>
-		auto Gen(TEnumerator& Enumerator)
+		TEnumeratorIterator(const TEnumeratorIterator&) = delete;
+		TEnumeratorIterator(TEnumeratorIterator&&) = default;
+
+		TIterator& Resume()
 		{
-			return TEnumeratorReverse<TEnumerator>(MoveTemp(Enumerator));
+			if (!Iterator)
+			{
+				Iterator = std::apply([](const TArgs&... Values) { return MakeUnique<TIterator>(Values...); }, Args);
+			}
+			else if (*Iterator)
+			{
+				++*Iterator;
+			}
+			return *Iterator;
 		}
-	};
 
-	template <typename TEnumerator, typename TPredicate>
-	struct TEnumeratorDistinctBy
-	{
-	public:
-		typedef typename TEnumerator::ElementType ElementType;
-		typedef typename Lambda<TPredicate>::ReturnType KeySelectorType;
-		TEnumerator Enumerator;
-		TPredicate&& Pred;
-		TArray<ElementType*> Distinct;
-		int Index = -1;
+		bool MoveNext()
+		{
+			TIterator& It = Resume();
+			if (It)
+			{
+				LINQ_COUNT(Yielded, 1);
+				Object = *It;
+				return true;
+			}
+			return false;
+		}
 
-		TEnumeratorDistinctBy(TEnumerator&& Enumerator, TPredicate&& Pred) : Enumerator(MoveTemp(Enumerator)), Pred(MoveTemp(Pred))
+		ElementType& Current()
 		{
+			return Object;
 		}
 
-		bool MoveNext()
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
 		{
-			if (Index == -1)
+			for (TIterator& It = Resume(); It; ++It)
 			{
-				TSet<KeySelectorType> Keys;
-				bool IsAlreadyInSet;
-				while (Enumerator.MoveNext())
+				LINQ_COUNT(Yielded, 1);
+				Object = *It;
+				if (!Sink(Object))
 				{
-					auto& Current = Enumerator.Current();
-					Keys.Emplace(Pred(Current), &IsAlreadyInSet);
-					if (!IsAlreadyInSet)
-					{
-						Distinct.Emplace(&Current);
-					}
+					return false;
 				}
 			}
+			return true;
+		}
+
+		static constexpr bool IsExactNum = false;
+		static constexpr bool IsStableReference = false;
+
+		int MaxNum() const
+		{
+			return 0;
+		}
+
+		template <typename TGenerator>
+		auto operator>>(TGenerator Generator)
+		{
+			return Generator.Gen(*this);
+		}
+	};
+
+	// One row of a column source: the column pointers and a row index, so a predicate only loads the columns it reads.
+	template <typename... TColumnTypes>
+	struct TColumnRow
+	{
+	public:
+		std::tuple<TColumnTypes*...> Columns;
+		int Index;
+
+		template <int ColumnIndex>
+		auto& Get() const
+		{
+			return std::get<ColumnIndex>(Columns)[Index];
+		}
+	};
+
+	// Parallel columns of equal length walked as one row set, e.g. positions, health and team stored apart.
+	template <typename... TColumnTypes>
+	struct TEnumeratorColumns
+	{
+	public:
+		typedef TColumnRow<TColumnTypes...> ElementType;
+		ElementType Row;
+		ElementType Probe;
+		int Size;
+		LINQ_STAGE_COUNTER("From")
+
+		TEnumeratorColumns(int Size, TColumnTypes*... Columns) : Row{std::make_tuple(Columns...), -1}, Probe(Row), Size(Size)
+		{
+		}
 
-			if (Index < Distinct.Num() - 1)
+		bool MoveNext()
+		{
+			if (Row.Index < Size - 1)
 			{
-				Index += 1;
+				LINQ_COUNT(Yielded, 1);
+				Row.Index += 1;
 				return true;
 			}
 			return false;
@@ -470,7 +781,52 @@ namespace Linq
 
 		ElementType& Current()
 		{
-			return *Distinct[Index];
+			return Row;
+		}
+
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			const int Start = Row.Index;
+			for (int Cursor = Start + 1; Cursor < Size; ++Cursor)
+			{
+				Row.Index = Cursor;
+				if (!Sink(Row))
+				{
+					LINQ_COUNT(Yielded, Cursor - Start);
+					return false;
+				}
+			}
+			LINQ_COUNT(Yielded, Size - 1 - Start);
+			Row.Index = Size - 1;
+			return true;
+		}
+
+		static constexpr bool IsExactNum = true;
+		static constexpr bool IsStableReference = false;
+
+		int MaxNum() const
+		{
+			return Size - Row.Index - 1;
+		}
+
+		static constexpr bool IsRandomAccess = true;
+
+		ElementType& ElementAt(int Offset)
+		{
+			Probe.Index = Row.Index + 1 + Offset;
+			return Probe;
+		}
+
+		void Advance(int Count)
+		{
+			Row.Index = FMath::Min(Row.Index + Count, Size - 1);
+		}
+
+		template <int ColumnIndex>
+		auto* ColumnData() const
+		{
+			return std::get<ColumnIndex>(Row.Columns);
 		}
 
 		template <typename TGenerator>
@@ -480,69 +836,190 @@ namespace Linq
 		}
 	};
 
-	template <typename TPredicate>
-	struct TGeneratorDistinctBy
+	// Projects one field of each row; the reference points into the column itself, so it stays valid.
+	template <typename TEnumerator, int ColumnIndex>
+	struct TEnumeratorColumn
 	{
 	public:
-		TPredicate&& Pred;
+		typedef std::remove_reference_t<decltype(DeclVal<typename TEnumerator::ElementType&>().template Get<ColumnIndex>())> ElementType;
+		TEnumerator Enumerator;
+		LINQ_STAGE_COUNTER("Column")
+
+		explicit TEnumeratorColumn(TEnumerator&& Enumerator) : Enumerator(MoveTemp(Enumerator))
+		{
+		}
+
+		bool MoveNext()
+		{
+			return Enumerator.MoveNext();
+		}
+
+		ElementType& Current()
+		{
+			return Enumerator.Current().template Get<ColumnIndex>();
+		}
+
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			return Enumerator.ForEach([&Sink](typename TEnumerator::ElementType& Row)
+			{
+				return Sink(Row.template Get<ColumnIndex>());
+			});
+		}
+
+		static constexpr bool IsExactNum = TEnumerator::IsExactNum;
+		static constexpr bool IsStableReference = true;
+
+		int MaxNum() const
+		{
+			return Enumerator.MaxNum();
+		}
+
+		static constexpr bool IsRandomAccess = TIsRandomAccess<TEnumerator>::Value;
+
+		ElementType& ElementAt(int Offset)
+		{
+			return Enumerator.ElementAt(Offset).template Get<ColumnIndex>();
+		}
+
+		void Advance(int Count)
+		{
+			Enumerator.Advance(Count);
+		}
 
-		TGeneratorDistinctBy(TPredicate&& Pred) : Pred(MoveTemp(Pred))
+		template <typename TGenerator>
+		auto operator>>(TGenerator Generator)
 		{
+			return Generator.Gen(*this);
 		}
+	};
 
+	template <int ColumnIndex>
+	struct TGeneratorColumn
+	{
+	public:
 		template <typename TEnumerator>
 		auto Gen(TEnumerator& Enumerator)
 		{
-			return TEnumeratorDistinctBy<TEnumerator, TPredicate>(MoveTemp(Enumerator), MoveTemp(Pred));
+			return TEnumeratorColumn<TEnumerator, ColumnIndex>(MoveTemp(Enumerator));
+		}
+
+		// Straight off the source the remaining rows of a column are contiguous, so it becomes a plain array.
+		template <typename... TColumnTypes>
+		auto Gen(TEnumeratorColumns<TColumnTypes...>& Enumerator)
+		{
+			typedef std::remove_pointer_t<std::tuple_element_t<ColumnIndex, std::tuple<TColumnTypes*...>>> ColumnType;
+			return TEnumeratorArray<ColumnType>(Enumerator.template ColumnData<ColumnIndex>() + Enumerator.Row.Index + 1, Enumerator.MaxNum());
 		}
 	};
 
-	template <typename TEnumerator, typename TEnumeratorKey, typename TPredicate>
-	struct TEnumeratorExceptBy
+	template <typename TEnumerator, typename TPredicate>
+	struct TEnumeratorWhere
 	{
 	public:
 		typedef typename TEnumerator::ElementType ElementType;
-		typedef typename TEnumeratorKey::ElementType ElementKeyType;
 		TEnumerator Enumerator;
-		TEnumeratorKey Key;
-		TPredicate&& Pred;
-		TArray<ElementKeyType*> ExceptValues;
-		bool MoveStart = false;
+		TPredicate Pred;
+		// Set only while a RunBudgeted tick drives this pipeline.
+		FBudgetClock* BudgetClock = nullptr;
 
-		TEnumeratorExceptBy(TEnumerator&& Enumerator, TEnumeratorKey&& Key, TPredicate&& Pred) : Enumerator(MoveTemp(Enumerator)), Key(MoveTemp(Key)), Pred(MoveTemp(Pred))
+		LINQ_STAGE_COUNTER("Where")
+
+		TEnumeratorWhere(TEnumerator&& Enumerator, TPredicate&& Pred) : Enumerator(MoveTemp(Enumerator)), Pred(Forward<TPredicate>(Pred))
 		{
 		}
 
 		bool MoveNext()
 		{
-			if (false == MoveStart)
+			while (Enumerator.MoveNext())
 			{
-				while (Key.MoveNext())
+				LINQ_COUNT(Pulled, 1);
+				if (LINQ_CALL(Pred(Enumerator.Current())))
 				{
-					ExceptValues.Add(&Key.Current());
+					LINQ_COUNT(Yielded, 1);
+					return true;
 				}
-				MoveStart = true;
 			}
+			return false;
+		}
 
-			while (Enumerator.MoveNext())
+		ElementType& Current()
+		{
+			return Enumerator.Current();
+		}
+
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			LINQ_TRACE_SCOPE(Linq_Where);
+			FBudgetClock* const Clock = BudgetClock;
+			return Enumerator.ForEach([this, &Sink, Clock](ElementType& Element)
+			{
+				LINQ_COUNT(Pulled, 1);
+				if (!LINQ_CALL(Pred(Element)))
+				{
+					// Rejected elements are charged too, so a long rejected stretch cannot hold a budgeted tick.
+					return nullptr == Clock || Clock->Consume();
+				}
+				LINQ_COUNT(Yielded, 1);
+				return Sink(Element);
+			});
+		}
+
+		static constexpr bool IsBatched = TIsBatched<TEnumerator>::Value && std::is_invocable<TPredicate&, const ElementType&>::value;
+
+		// The mask pass and the branch-free compress store are both simple enough for the compiler to vectorize.
+		const ElementType* NextBatch(ElementType* Scratch, int& Num)
+		{
+			ElementType UpstreamScratch[BatchSize];
+			bool Mask[BatchSize];
+			int UpstreamNum;
+			Num = 0;
+			while (Num == 0)
 			{
-				for (ElementKeyType* Value : ExceptValues)
+				const ElementType* Batch = Enumerator.NextBatch(UpstreamScratch, UpstreamNum);
+				if (UpstreamNum == 0)
+				{
+					break;
+				}
+				LINQ_COUNT(Pulled, UpstreamNum);
+				LINQ_COUNT(PredicateCalls, UpstreamNum);
 				{
-					if (*Value == Pred(Enumerator.Current()))
+					LINQ_CYCLE_SCOPE();
+					for (int i = 0; i < UpstreamNum; ++i)
 					{
-						MoveNext();
+						Mask[i] = Pred(Batch[i]);
 					}
 				}
-				return true;
+				for (int i = 0; i < UpstreamNum; ++i)
+				{
+					Scratch[Num] = Batch[i];
+					Num += Mask[i] ? 1 : 0;
+				}
 			}
-			return false;
+			LINQ_COUNT(Yielded, Num);
+			return Scratch;
 		}
 
-		ElementType& Current()
+		static constexpr bool IsExactNum = false;
+		static constexpr bool IsStableReference = TEnumerator::IsStableReference;
+
+		int MaxNum() const
 		{
-			return Enumerator.Current();
+			return Enumerator.MaxNum();
+		}
+
+		template <typename TSource>
+		TEnumeratorRef<TEnumeratorWhere> Rebind(TSource& Source)
+		{
+			Enumerator.Rebind(Source);
+			return TEnumeratorRef<TEnumeratorWhere>(*this);
 		}
 
+		template <typename TSource>
+		void Rebind(TSource&& Source) = delete;
+
 		template <typename TGenerator>
 		auto operator>>(TGenerator Generator)
 		{
@@ -550,88 +1027,4246 @@ namespace Linq
 		}
 	};
 
+	// Where >> Where: one stage that short-circuits through both predicates.
+	template <typename TFirst, typename TSecond>
+	struct TFusedWhere
+	{
+	public:
+		TFirst First;
+		TSecond Second;
+
+		template <typename T>
+		auto operator()(T& Element) -> decltype(First(Element) && Second(Element))
+		{
+			return First(Element) && Second(Element);
+		}
+	};
 
-	template <typename TEnumeratorKey, typename TPredicate>
-	struct TGeneratorExceptBy
+	template <typename TPredicate>
+	struct TGeneratorWhere
 	{
 	public:
-		TEnumeratorKey Key;
-		TPredicate&& Pred;
+		TPredicate Pred;
 
-		TGeneratorExceptBy(TEnumeratorKey&& Key, TPredicate&& Pred) : Key(MoveTemp(Key)), Pred(MoveTemp(Pred))
+		TGeneratorWhere(TPredicate&& Pred) : Pred(Forward<TPredicate>(Pred))
 		{
 		}
 
 		template <typename TEnumerator>
 		auto Gen(TEnumerator& Enumerator)
 		{
-			return TEnumeratorExceptBy<TEnumerator, TEnumeratorKey, TPredicate>(MoveTemp(Enumerator), MoveTemp(Key), MoveTemp(Pred));
+			return TEnumeratorWhere<TEnumerator, TPredicate>(MoveTemp(Enumerator), Forward<TPredicate>(Pred));
 		}
-	};
-}
 
-template <typename T>
-auto From(TArray<T>& Array)
-{
-	return Linq::TEnumeratorArray<T>(Array.GetData(), Array.Num());
-}
+		template <typename TUpstream, typename TFirst>
+		auto Gen(TEnumeratorWhere<TUpstream, TFirst>& Enumerator)
+		{
+			typedef TFusedWhere<TFirst, TPredicate> FusedType;
+			return TEnumeratorWhere<TUpstream, FusedType>(MoveTemp(Enumerator.Enumerator), FusedType{Forward<TFirst>(Enumerator.Pred), Forward<TPredicate>(Pred)});
+		}
+	};
 
-template <typename T>
-auto From(TArray<T>&& Array)
-{
-	return Linq::TEnumeratorArray<T>(MoveTemp(Array));
-}
+	template <typename TPredicate>
+	struct Lambda : public Lambda<decltype(&TPredicate::operator())>
+	{
+	};
 
-template <typename... T>
-auto From(T&&... Args)
-{
-	TArray<std::common_type_t<T...>> Array;
-	(Array.Emplace(MoveTemp(Args)), ...);
-	return From(MoveTemp(Array));
-}
+	template <typename TPredicate>
+	struct Lambda<TPredicate&> : public Lambda<TPredicate>
+	{
+	};
 
-template <typename TPredicate>
-auto Where(TPredicate&& Pred)
-{
-	return Linq::TGeneratorWhere<TPredicate>(MoveTemp(Pred));
-}
+	template <typename TClass, typename TReturn, typename... Args>
+	struct Lambda<TReturn(TClass::*)(Args...) const>
+	{
+		typedef TReturn ReturnType;
+	};
 
-template <typename TPredicate>
-auto Select(TPredicate&& Pred)
-{
-	return Linq::TGeneratorSelect<TPredicate>(MoveTemp(Pred));
-}
+	template <typename TEnumerator, typename TPredicate>
+	struct TEnumeratorSelect
+	{
+		typedef std::invoke_result_t<TPredicate&, typename TEnumerator::ElementType&> ReturnType;
+		// A projection that returns a reference (e.g. a member of the element) is forwarded without a copy,
+		// keeping its constness so a const source cannot be written through it.
+		static constexpr bool IsReferenceProjection = std::is_lvalue_reference<ReturnType>::value;
+		typedef std::conditional_t<IsReferenceProjection, std::remove_reference_t<ReturnType>, std::remove_cv_t<std::remove_reference_t<ReturnType>>> ElementType;
+		typedef std::conditional_t<IsReferenceProjection, ElementType*, TOptional<ElementType>> CurrentType;
+		TEnumerator Enumerator;
+		TPredicate Pred;
+		CurrentType CurrentValue{};
+		LINQ_STAGE_COUNTER("Select")
 
-inline auto ToArray()
-{
-	return Linq::TGeneratorToArray();
-}
+		TEnumeratorSelect(TEnumerator&& Enumerator, TPredicate&& Pred) : Enumerator(MoveTemp(Enumerator)), Pred(Forward<TPredicate>(Pred))
+		{
+		}
 
-template <typename TPredicate>
-auto OrderBy(TPredicate&& Pred)
-{
-	return Linq::TGeneratorOrderBy<TPredicate>(MoveTemp(Pred));
-}
+		bool MoveNext()
+		{
+			while (Enumerator.MoveNext())
+			{
+				LINQ_COUNT(Pulled, 1);
+				LINQ_COUNT(Yielded, 1);
+				if constexpr (IsReferenceProjection)
+				{
+					CurrentValue = &LINQ_CALL(Pred(Enumerator.Current()));
+				}
+				else
+				{
+					CurrentValue.Emplace(LINQ_CALL(Pred(Enumerator.Current())));
+				}
+				return true;
+			}
+			return false;
+		}
+
+		ElementType& Current()
+		{
+			if constexpr (IsReferenceProjection)
+			{
+				return *CurrentValue;
+			}
+			else
+			{
+				return CurrentValue.GetValue();
+			}
+		}
+
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			LINQ_TRACE_SCOPE(Linq_Select);
+			return Enumerator.ForEach([this, &Sink](typename TEnumerator::ElementType& Element)
+			{
+				LINQ_COUNT(Pulled, 1);
+				LINQ_COUNT(Yielded, 1);
+				if constexpr (IsReferenceProjection)
+				{
+					return Sink(LINQ_CALL(Pred(Element)));
+				}
+				else
+				{
+					ElementType Value = LINQ_CALL(Pred(Element));
+					return Sink(Value);
+				}
+			});
+		}
+
+		static constexpr bool IsBatched = TIsBatched<TEnumerator>::Value && std::is_arithmetic<ElementType>::value && !std::is_const<ElementType>::value && std::is_invocable<TPredicate&, const typename TEnumerator::ElementType&>::value;
+
+		const ElementType* NextBatch(ElementType* Scratch, int& Num)
+		{
+			typename TEnumerator::ElementType UpstreamScratch[BatchSize];
+			const auto* Batch = Enumerator.NextBatch(UpstreamScratch, Num);
+			LINQ_COUNT(Pulled, Num);
+			LINQ_COUNT(Yielded, Num);
+			LINQ_COUNT(PredicateCalls, Num);
+			LINQ_CYCLE_SCOPE();
+			for (int i = 0; i < Num; ++i)
+			{
+				Scratch[i] = Pred(Batch[i]);
+			}
+			return Scratch;
+		}
+
+		static constexpr bool IsExactNum = TEnumerator::IsExactNum;
+		static constexpr bool IsStableReference = IsReferenceProjection && TEnumerator::IsStableReference;
+		static constexpr bool IsRandomAccess = TIsRandomAccess<TEnumerator>::Value;
+
+		ElementType& ElementAt(int Offset)
+		{
+			LINQ_COUNT(Pulled, 1);
+			LINQ_COUNT(Yielded, 1);
+			if constexpr (IsReferenceProjection)
+			{
+				return LINQ_CALL(Pred(Enumerator.ElementAt(Offset)));
+			}
+			else
+			{
+				return CurrentValue.Emplace(LINQ_CALL(Pred(Enumerator.ElementAt(Offset))));
+			}
+		}
+
+		void Advance(int Count)
+		{
+			Enumerator.Advance(Count);
+		}
+
+		int MaxNum() const
+		{
+			return Enumerator.MaxNum();
+		}
+
+		template <typename TSource>
+		TEnumeratorRef<TEnumeratorSelect> Rebind(TSource& Source)
+		{
+			Enumerator.Rebind(Source);
+			return TEnumeratorRef<TEnumeratorSelect>(*this);
+		}
+
+		template <typename TSource>
+		void Rebind(TSource&& Source) = delete;
+
+		template <typename TGenerator>
+		auto operator>>(TGenerator Generator)
+		{
+			return Generator.Gen(*this);
+		}
+	};
+
+	// Select >> Select: one stage applying both projections, with the same hand-off as two stages
+	// (a reference is forwarded, a value is held in a local for the second projection).
+	template <typename TFirst, typename TSecond>
+	struct TFusedSelect
+	{
+	public:
+		TFirst First;
+		TSecond Second;
+
+		template <typename T>
+		using TIntermediate = std::remove_cv_t<std::remove_reference_t<decltype(DeclVal<TFirst&>()(DeclVal<T&>()))>>;
+
+		// A reference from the first projection is handed on as is (const included); a value is held in a local.
+		template <typename T>
+		using TSecondArgument = std::conditional_t<std::is_lvalue_reference<decltype(DeclVal<TFirst&>()(DeclVal<T&>()))>::value, decltype(DeclVal<TFirst&>()(DeclVal<T&>())), TIntermediate<T>&>;
+
+		template <typename T>
+		auto operator()(T& Element) -> decltype(Second(DeclVal<TSecondArgument<T>>()))
+		{
+			if constexpr (std::is_lvalue_reference<decltype(First(Element))>::value)
+			{
+				return Second(First(Element));
+			}
+			else
+			{
+				TIntermediate<T> Value = First(Element);
+				return Second(Value);
+			}
+		}
+	};
+
+	template <typename TPredicate>
+	struct TGeneratorSelect
+	{
+	public:
+		TPredicate Pred;
+
+		TGeneratorSelect(TPredicate&& Pred) : Pred(Forward<TPredicate>(Pred))
+		{
+		}
+
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			return TEnumeratorSelect<TEnumerator, TPredicate>(MoveTemp(Enumerator), Forward<TPredicate>(Pred));
+		}
+
+		template <typename TUpstream, typename TFirst>
+		auto Gen(TEnumeratorSelect<TUpstream, TFirst>& Enumerator)
+		{
+			typedef TEnumeratorSelect<TUpstream, TFirst> UpstreamType;
+			typedef std::invoke_result_t<TPredicate&, typename UpstreamType::ElementType&> SecondType;
+			// Once fused, the first projection's value only lives for one call, so anything that could point into it
+			// (a reference, a pointer, a view, a struct holding either) keeps its own stage. Plain numbers are safe.
+			if constexpr (UpstreamType::IsReferenceProjection || std::is_arithmetic<SecondType>::value || std::is_enum<SecondType>::value)
+			{
+				typedef TFusedSelect<TFirst, TPredicate> FusedType;
+				return TEnumeratorSelect<TUpstream, FusedType>(MoveTemp(Enumerator.Enumerator), FusedType{Forward<TFirst>(Enumerator.Pred), Forward<TPredicate>(Pred)});
+			}
+			else
+			{
+				return TEnumeratorSelect<UpstreamType, TPredicate>(MoveTemp(Enumerator), Forward<TPredicate>(Pred));
+			}
+		}
+	};
+
+	template <typename TAllocator = FDefaultAllocator>
+	struct TGeneratorToArray
+	{
+	public:
+		TGeneratorToArray()
+		{
+		}
+
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			typedef typename TEnumerator::ElementType ElementType;
+			TArray<std::remove_const_t<ElementType>, TAllocator> Array;
+			// MaxNum is only an upper bound after a filter, so reserving it could allocate the whole upstream.
+			if constexpr (TEnumerator::IsExactNum)
+			{
+				Array.Reserve(Enumerator.MaxNum());
+			}
+			if constexpr (TIsBatched<TEnumerator>::Value)
+			{
+				ElementType Scratch[BatchSize];
+				int Num;
+				const ElementType* Batch = Enumerator.NextBatch(Scratch, Num);
+				while (Num > 0)
+				{
+					Array.Append(Batch, Num);
+					Batch = Enumerator.NextBatch(Scratch, Num);
+				}
+			}
+			else
+			{
+				Enumerator.ForEach([&Array](ElementType& Element)
+				{
+					if constexpr (TEnumerator::IsStableReference)
+					{
+						Array.Emplace(Element);
+					}
+					else
+					{
+						Array.Emplace(MoveTemp(Element));
+					}
+					return true;
+				});
+			}
+			return Array;
+		}
+
+		template <typename TElementType>
+		auto Gen(TEnumeratorArray<TElementType>& Enumerator)
+		{
+			if constexpr (std::is_same<TAllocator, FDefaultAllocator>::value)
+			{
+				if (Enumerator.IsOwnedUntouched())
+				{
+					Enumerator.Size = 0;
+					Enumerator.Data = nullptr;
+					return MoveTemp(Enumerator.Container);
+				}
+			}
+			// Copies what is left from the cursor on and leaves the source drained, like the generic path.
+			TArray<std::remove_const_t<TElementType>, TAllocator> Array(Enumerator.Data + Enumerator.Index + 1, Enumerator.MaxNum());
+			Enumerator.Advance(Enumerator.MaxNum());
+			return Array;
+		}
+	};
+
+	template <typename TKeySelector, typename TValueSelector, typename TSetAllocator = FDefaultSetAllocator>
+	struct TGeneratorToMap
+	{
+	public:
+		typedef std::decay_t<typename Lambda<TKeySelector>::ReturnType> KeyType;
+		typedef std::decay_t<typename Lambda<TValueSelector>::ReturnType> ValueType;
+		TKeySelector KeySelector;
+		TValueSelector ValueSelector;
+
+		TGeneratorToMap(TKeySelector&& KeySelector, TValueSelector&& ValueSelector) : KeySelector(Forward<TKeySelector>(KeySelector)), ValueSelector(Forward<TValueSelector>(ValueSelector))
+		{
+		}
+
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			TMap<KeyType, ValueType, TSetAllocator> Map;
+			if constexpr (TEnumerator::IsExactNum)
+			{
+				Map.Reserve(Enumerator.MaxNum());
+			}
+			Enumerator.ForEach([this, &Map](typename TEnumerator::ElementType& Element)
+			{
+				Map.Add(KeySelector(Element), ValueSelector(Element));
+				return true;
+			});
+			return Map;
+		}
+	};
+
+	template <typename TSetAllocator = FDefaultSetAllocator>
+	struct TGeneratorToSet
+	{
+	public:
+		TGeneratorToSet()
+		{
+		}
+
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			typedef std::remove_const_t<typename TEnumerator::ElementType> ValueType;
+			TSet<ValueType, DefaultKeyFuncs<ValueType>, TSetAllocator> Set;
+			if constexpr (TEnumerator::IsExactNum)
+			{
+				Set.Reserve(Enumerator.MaxNum());
+			}
+			Enumerator.ForEach([&Set](typename TEnumerator::ElementType& Element)
+			{
+				Set.Emplace(Element);
+				return true;
+			});
+			return Set;
+		}
+	};
+
+	template <typename TAction>
+	struct TGeneratorForEach
+	{
+	public:
+		TAction Action;
+
+		TGeneratorForEach(TAction&& Action) : Action(Forward<TAction>(Action))
+		{
+		}
+
+		template <typename TEnumerator>
+		void Gen(TEnumerator& Enumerator)
+		{
+			Enumerator.ForEach([this](typename TEnumerator::ElementType& Element)
+			{
+				Action(Element);
+				return true;
+			});
+		}
+	};
+
+	struct TGeneratorElementAt
+	{
+	public:
+		int Index;
+
+		TGeneratorElementAt(int Index) : Index(Index)
+		{
+		}
+
+		template <typename TEnumerator>
+		TOptional<std::remove_const_t<typename TEnumerator::ElementType>> Gen(TEnumerator& Enumerator)
+		{
+			typedef typename TEnumerator::ElementType ElementType;
+			if (Index < 0)
+			{
+				return {};
+			}
+
+			if constexpr (TIsRandomAccess<TEnumerator>::Value)
+			{
+				if (Index >= Enumerator.MaxNum())
+				{
+					return {};
+				}
+				return Enumerator.ElementAt(Index);
+			}
+			else
+			{
+				TOptional<std::remove_const_t<ElementType>> Result;
+				int Remaining = Index;
+				Enumerator.ForEach([&Result, &Remaining](ElementType& Element)
+				{
+					if (Remaining-- > 0)
+					{
+						return true;
+					}
+					if constexpr (TEnumerator::IsStableReference)
+					{
+						Result.Emplace(Element);
+					}
+					else
+					{
+						Result.Emplace(MoveTemp(Element));
+					}
+					return false;
+				});
+				return Result;
+			}
+		}
+	};
+
+	struct TGeneratorLast
+	{
+	public:
+		template <typename TEnumerator>
+		TOptional<std::remove_const_t<typename TEnumerator::ElementType>> Gen(TEnumerator& Enumerator)
+		{
+			typedef typename TEnumerator::ElementType ElementType;
+			if constexpr (TIsRandomAccess<TEnumerator>::Value)
+			{
+				const int Num = Enumerator.MaxNum();
+				if (Num <= 0)
+				{
+					return {};
+				}
+				return Enumerator.ElementAt(Num - 1);
+			}
+			else if constexpr (TEnumerator::IsStableReference)
+			{
+				ElementType* Result = nullptr;
+				Enumerator.ForEach([&Result](ElementType& Element)
+				{
+					Result = &Element;
+					return true;
+				});
+				if (Result == nullptr)
+				{
+					return {};
+				}
+				return *Result;
+			}
+			else
+			{
+				TOptional<std::remove_const_t<ElementType>> Result;
+				Enumerator.ForEach([&Result](ElementType& Element)
+				{
+					Result.Emplace(MoveTemp(Element));
+					return true;
+				});
+				return Result;
+			}
+		}
+	};
+
+	template <typename TPredicate = void>
+	struct TGeneratorAny
+	{
+	public:
+		TPredicate Pred;
+
+		TGeneratorAny(TPredicate&& Pred) : Pred(Forward<TPredicate>(Pred))
+		{
+		}
+
+		template <typename TEnumerator>
+		bool Gen(TEnumerator& Enumerator)
+		{
+			return false == Enumerator.ForEach([this](typename TEnumerator::ElementType& Element)
+			{
+				return !Pred(Element);
+			});
+		}
+	};
+
+	template <>
+	struct TGeneratorAny<void>
+	{
+	public:
+		template <typename TEnumerator>
+		bool Gen(TEnumerator& Enumerator)
+		{
+			if constexpr (TEnumerator::IsExactNum)
+			{
+				return Enumerator.MaxNum() > 0;
+			}
+			else
+			{
+				return Enumerator.MoveNext();
+			}
+		}
+	};
+
+	template <typename TPredicate>
+	struct TGeneratorAll
+	{
+	public:
+		TPredicate Pred;
+
+		TGeneratorAll(TPredicate&& Pred) : Pred(Forward<TPredicate>(Pred))
+		{
+		}
+
+		template <typename TEnumerator>
+		bool Gen(TEnumerator& Enumerator)
+		{
+			return Enumerator.ForEach([this](typename TEnumerator::ElementType& Element)
+			{
+				return static_cast<bool>(Pred(Element));
+			});
+		}
+	};
+
+	template <typename TValue>
+	struct TGeneratorContains
+	{
+	public:
+		TValue Value;
+
+		TGeneratorContains(TValue&& Value) : Value(Forward<TValue>(Value))
+		{
+		}
+
+		template <typename TEnumerator>
+		bool Gen(TEnumerator& Enumerator)
+		{
+			return false == Enumerator.ForEach([this](typename TEnumerator::ElementType& Element)
+			{
+				return !(Element == Value);
+			});
+		}
+	};
+
+	struct TGeneratorFirst
+	{
+	public:
+		template <typename TEnumerator>
+		TOptional<std::remove_const_t<typename TEnumerator::ElementType>> Gen(TEnumerator& Enumerator)
+		{
+			typedef typename TEnumerator::ElementType ElementType;
+			TOptional<std::remove_const_t<ElementType>> Result;
+			Enumerator.ForEach([&Result](ElementType& Element)
+			{
+				if constexpr (TEnumerator::IsStableReference)
+				{
+					Result.Emplace(Element);
+				}
+				else
+				{
+					Result.Emplace(MoveTemp(Element));
+				}
+				return false;
+			});
+			return Result;
+		}
+	};
+
+	struct TGeneratorCount
+	{
+	public:
+		template <typename TEnumerator>
+		int Gen(TEnumerator& Enumerator)
+		{
+			typedef typename TEnumerator::ElementType ElementType;
+			if constexpr (TEnumerator::IsExactNum)
+			{
+				return Enumerator.MaxNum();
+			}
+			else if constexpr (TIsBatched<TEnumerator>::Value)
+			{
+				ElementType Scratch[BatchSize];
+				int Count = 0;
+				int Num;
+				Enumerator.NextBatch(Scratch, Num);
+				while (Num > 0)
+				{
+					Count += Num;
+					Enumerator.NextBatch(Scratch, Num);
+				}
+				return Count;
+			}
+			else
+			{
+				int Count = 0;
+				Enumerator.ForEach([&Count](ElementType&)
+				{
+					Count += 1;
+					return true;
+				});
+				return Count;
+			}
+		}
+	};
+
+	// Feeds the remaining elements round-robin into four accumulators so consecutive updates do not wait on each other.
+	template <typename TEnumerator, typename TLane, typename TReduce>
+	int ReduceLanes(TEnumerator& Enumerator, TLane (&Lanes)[4], TReduce&& Reduce)
+	{
+		typedef typename TEnumerator::ElementType ElementType;
+		int Count = 0;
+		if constexpr (TIsBatched<TEnumerator>::Value)
+		{
+			ElementType Scratch[BatchSize];
+			int Num;
+			const ElementType* Batch = Enumerator.NextBatch(Scratch, Num);
+			while (Num > 0)
+			{
+				int i = 0;
+				for (; i + 4 <= Num; i += 4)
+				{
+					Reduce(Lanes[0], Batch[i]);
+					Reduce(Lanes[1], Batch[i + 1]);
+					Reduce(Lanes[2], Batch[i + 2]);
+					Reduce(Lanes[3], Batch[i + 3]);
+				}
+				for (; i < Num; ++i)
+				{
+					Reduce(Lanes[0], Batch[i]);
+				}
+				Count += Num;
+				Batch = Enumerator.NextBatch(Scratch, Num);
+			}
+		}
+		else
+		{
+			Enumerator.ForEach([&Lanes, &Reduce, &Count](ElementType& Element)
+			{
+				Reduce(Lanes[Count & 3], Element);
+				Count += 1;
+				return true;
+			});
+		}
+		return Count;
+	}
+
+	struct TGeneratorSum
+	{
+	public:
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			typedef std::remove_const_t<typename TEnumerator::ElementType> ElementType;
+			static_assert(std::is_arithmetic<ElementType>::value, "Sum requires arithmetic elements, Select a numeric key first");
+			ElementType Lanes[4] = {};
+			ReduceLanes(Enumerator, Lanes, [](ElementType& Lane, ElementType Value)
+			{
+				Lane += Value;
+			});
+			return static_cast<ElementType>((Lanes[0] + Lanes[1]) + (Lanes[2] + Lanes[3]));
+		}
+	};
+
+	struct TGeneratorAverage
+	{
+	public:
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			typedef std::remove_const_t<typename TEnumerator::ElementType> ElementType;
+			static_assert(std::is_arithmetic<ElementType>::value, "Average requires arithmetic elements, Select a numeric key first");
+			typedef std::conditional_t<std::is_floating_point<ElementType>::value, ElementType, double> AverageType;
+			AverageType Lanes[4] = {};
+			const int Count = ReduceLanes(Enumerator, Lanes, [](AverageType& Lane, ElementType Value)
+			{
+				Lane += Value;
+			});
+			if (Count == 0)
+			{
+				return TOptional<AverageType>();
+			}
+			return TOptional<AverageType>(((Lanes[0] + Lanes[1]) + (Lanes[2] + Lanes[3])) / Count);
+		}
+	};
+
+	template <bool IsMax>
+	struct TGeneratorMinMax
+	{
+	public:
+		template <typename TElementType>
+		static bool IsBetter(const TElementType& Value, const TElementType& Best)
+		{
+			if constexpr (IsMax)
+			{
+				return Best < Value;
+			}
+			else
+			{
+				return Value < Best;
+			}
+		}
+
+		template <typename TEnumerator>
+		TOptional<std::remove_const_t<typename TEnumerator::ElementType>> Gen(TEnumerator& Enumerator)
+		{
+			typedef typename TEnumerator::ElementType ElementType;
+			if (false == Enumerator.MoveNext())
+			{
+				return {};
+			}
+
+			if constexpr (std::is_arithmetic<ElementType>::value)
+			{
+				typedef std::remove_const_t<ElementType> LaneType;
+				const LaneType First = Enumerator.Current();
+				LaneType Lanes[4] = {First, First, First, First};
+				ReduceLanes(Enumerator, Lanes, [](LaneType& Lane, LaneType Value)
+				{
+					Lane = IsBetter(Value, Lane) ? Value : Lane;
+				});
+				LaneType Best = Lanes[0];
+				for (int i = 1; i < 4; ++i)
+				{
+					Best = IsBetter(Lanes[i], Best) ? Lanes[i] : Best;
+				}
+				return Best;
+			}
+			else if constexpr (TEnumerator::IsStableReference)
+			{
+				ElementType* Best = &Enumerator.Current();
+				Enumerator.ForEach([&Best](ElementType& Element)
+				{
+					if (IsBetter(Element, *Best))
+					{
+						Best = &Element;
+					}
+					return true;
+				});
+				return *Best;
+			}
+			else
+			{
+				TOptional<std::remove_const_t<ElementType>> Best;
+				Best.Emplace(MoveTemp(Enumerator.Current()));
+				Enumerator.ForEach([&Best](ElementType& Element)
+				{
+					if (IsBetter(Element, Best.GetValue()))
+					{
+						Best.Emplace(MoveTemp(Element));
+					}
+					return true;
+				});
+				return Best;
+			}
+		}
+	};
+
+	template <typename TElementType, bool IsStableReference, typename TAllocator = FDefaultAllocator>
+	struct TElementBuffer
+	{
+	public:
+		TArray<TElementType*, TAllocator> Items;
+
+		void Reserve(int Num)
+		{
+			Items.Reserve(Num);
+		}
+
+		void Reset()
+		{
+			Items.Reset();
+		}
+
+		void Add(TElementType& Element)
+		{
+			Items.Emplace(&Element);
+		}
+
+		void Set(int Index, TElementType& Element)
+		{
+			Items[Index] = &Element;
+		}
+
+		int Num() const
+		{
+			return Items.Num();
+		}
+
+		TElementType& operator[](int Index)
+		{
+			return *Items[Index];
+		}
+	};
+
+	// The upstream hands out a reference that is overwritten by the next element (e.g. Select), so keep copies.
+	template <typename TElementType, typename TAllocator>
+	struct TElementBuffer<TElementType, false, TAllocator>
+	{
+	public:
+		TArray<TElementType, TAllocator> Items;
+
+		void Reserve(int Num)
+		{
+			Items.Reserve(Num);
+		}
+
+		void Reset()
+		{
+			Items.Reset();
+		}
+
+		void Add(TElementType& Element)
+		{
+			Items.Emplace(MoveTemp(Element));
+		}
+
+		void Set(int Index, TElementType& Element)
+		{
+			Items[Index] = MoveTemp(Element);
+		}
+
+		int Num() const
+		{
+			return Items.Num();
+		}
+
+		TElementType& operator[](int Index)
+		{
+			return Items[Index];
+		}
+	};
+
+	template <int Size>
+	struct TSortRadixWord;
+
+	template <>
+	struct TSortRadixWord<1>
+	{
+		typedef uint8 Type;
+	};
+
+	template <>
+	struct TSortRadixWord<2>
+	{
+		typedef uint16 Type;
+	};
+
+	template <>
+	struct TSortRadixWord<4>
+	{
+		typedef uint32 Type;
+	};
+
+	template <>
+	struct TSortRadixWord<8>
+	{
+		typedef uint64 Type;
+	};
+
+	template <typename TKey, bool IsAscending, bool IsArithmetic = std::is_arithmetic<TKey>::value>
+	struct TSortKey
+	{
+	public:
+		static constexpr bool IsRadix = false;
+		static constexpr int NumRadixBytes = 0;
+		TKey Key;
+
+		TSortKey(TKey Key) : Key(MoveTemp(Key))
+		{
+		}
+
+		bool operator<(const TSortKey& Other) const
+		{
+			return IsAscending ? Key < Other.Key : Other.Key < Key;
+		}
+	};
+
+	// Arithmetic keys are stored as unsigned words that order the same way, so they can be radix sorted.
+	template <typename TKey, bool IsAscending>
+	struct TSortKey<TKey, IsAscending, true>
+	{
+	public:
+		typedef typename TSortRadixWord<sizeof(TKey)>::Type WordType;
+		static constexpr bool IsRadix = true;
+		static constexpr int NumRadixBytes = sizeof(TKey);
+		static constexpr WordType SignBit = WordType(1) << (sizeof(TKey) * 8 - 1);
+		WordType Key;
+
+		TSortKey() = default;
+
+		TSortKey(TKey Value)
+		{
+			if constexpr (std::is_floating_point<TKey>::value)
+			{
+				// -0.0 compares equal to +0.0, so both must map to the same word.
+				Value = Value == TKey(0) ? TKey(0) : Value;
+			}
+			WordType Bits;
+			FMemory::Memcpy(&Bits, &Value, sizeof(TKey));
+			if constexpr (std::is_floating_point<TKey>::value)
+			{
+				Bits = (Bits & SignBit) ? WordType(~Bits) : WordType(Bits | SignBit);
+			}
+			else if constexpr (std::is_signed<TKey>::value)
+			{
+				Bits ^= SignBit;
+			}
+			Key = IsAscending ? Bits : WordType(~Bits);
+		}
+
+		uint8 RadixByte(int ByteIndex) const
+		{
+			return uint8(Key >> (ByteIndex * 8));
+		}
+
+		bool operator<(const TSortKey& Other) const
+		{
+			return Key < Other.Key;
+		}
+	};
+
+	template <typename TParentKey, typename TOwnKey>
+	struct TSortKeyThen
+	{
+	public:
+		static constexpr bool IsRadix = TParentKey::IsRadix && TOwnKey::IsRadix;
+		static constexpr int NumRadixBytes = TParentKey::NumRadixBytes + TOwnKey::NumRadixBytes;
+		TParentKey Parent;
+		TOwnKey Own;
+
+		TSortKeyThen() = default;
+
+		TSortKeyThen(TParentKey&& Parent, TOwnKey&& Own) : Parent(MoveTemp(Parent)), Own(MoveTemp(Own))
+		{
+		}
+
+		uint8 RadixByte(int ByteIndex) const
+		{
+			return ByteIndex < TOwnKey::NumRadixBytes ? Own.RadixByte(ByteIndex) : Parent.RadixByte(ByteIndex - TOwnKey::NumRadixBytes);
+		}
+
+		bool operator<(const TSortKeyThen& Other) const
+		{
+			if (Parent < Other.Parent)
+			{
+				return true;
+			}
+			if (Other.Parent < Parent)
+			{
+				return false;
+			}
+			return Own < Other.Own;
+		}
+	};
+
+	template <typename TKey>
+	struct TSortEntry
+	{
+	public:
+		TKey Key;
+		int Index;
+	};
+
+	// One pass of an LSD radix sort on byte ByteIndex of every key. The pass is stable, so equal keys keep their
+	// source order without an explicit tie-break; the result is swapped into Entries.
+	template <typename TKey, typename TAllocator>
+	void RadixSortPass(TArray<TSortEntry<TKey>, TAllocator>& Entries, TArray<TSortEntry<TKey>, TAllocator>& Buffer, int ByteIndex)
+	{
+		const int Num = Entries.Num();
+		const TSortEntry<TKey>* Src = Entries.GetData();
+		int Offsets[256] = {};
+		for (int i = 0; i < Num; ++i)
+		{
+			Offsets[Src[i].Key.RadixByte(ByteIndex)] += 1;
+		}
+		if (Offsets[Src[0].Key.RadixByte(ByteIndex)] == Num)
+		{
+			return;
+		}
+		int Offset = 0;
+		for (int& Count : Offsets)
+		{
+			const int Bucket = Count;
+			Count = Offset;
+			Offset += Bucket;
+		}
+		Buffer.Reset(Num);
+		Buffer.AddUninitialized(Num);
+		TSortEntry<TKey>* Dst = Buffer.GetData();
+		for (int i = 0; i < Num; ++i)
+		{
+			Dst[Offsets[Src[i].Key.RadixByte(ByteIndex)]++] = Src[i];
+		}
+		Swap(Entries, Buffer);
+	}
+
+	template <typename TKey>
+	bool SortEntryLess(const TSortEntry<TKey>& L, const TSortEntry<TKey>& R)
+	{
+		if (L.Key < R.Key)
+		{
+			return true;
+		}
+		return !(R.Key < L.Key) && L.Index < R.Index;
+	}
+
+	// Radix keys are sorted one byte pass at a time, charged to Budget, and RadixPass records where to resume.
+	// A comparison sort runs in one step.
+	template <typename TKey, typename TAllocator, typename TBudget>
+	bool SortEntries(TArray<TSortEntry<TKey>, TAllocator>& Entries, TArray<TSortEntry<TKey>, TAllocator>& Scratch, int& RadixPass, TBudget& Budget)
+	{
+		if constexpr (TKey::IsRadix)
+		{
+			if (Entries.Num() >= 64)
+			{
+				while (RadixPass < TKey::NumRadixBytes)
+				{
+					RadixSortPass(Entries, Scratch, RadixPass);
+					RadixPass += 1;
+					if (RadixPass < TKey::NumRadixBytes && false == Budget.Consume(Entries.Num()))
+					{
+						return false;
+					}
+				}
+				return true;
+			}
+		}
+		Algo::Sort(Entries, SortEntryLess<TKey>);
+		return true;
+	}
+
+	template <typename TKey>
+	struct TTopEntry
+	{
+	public:
+		TSortEntry<TKey> Entry;
+		int Slot;
+	};
+
+	// Keeps the Count smallest (key, source index) entries in a max-heap, so ties still resolve in source order.
+	// Returns false when Budget ran out before the upstream was drained; the next call resumes there.
+	template <typename TEnumeratorSort, typename TBudget>
+	bool GatherTopSorted(TEnumeratorSort& Enumerator, int Count, TBudget& Budget)
+	{
+		typedef typename TEnumeratorSort::KeyType KeyType;
+		auto& Heap = Enumerator.TopHeap;
+		if (Count > 0)
+		{
+			auto Greater = [](const TTopEntry<KeyType>& L, const TTopEntry<KeyType>& R)
+			{
+				return SortEntryLess(R.Entry, L.Entry);
+			};
+			// A large Count (e.g. a saturated Skip + Take) is only reserved up to a known upstream bound.
+			const int ForwardNum = Enumerator.ForwardMaxNum();
+			if (Enumerator.Ordinal == 0 && ForwardNum > 0)
+			{
+				Heap.Reserve(FMath::Min(Count, ForwardNum));
+				Enumerator.Elements.Reserve(FMath::Min(Count, ForwardNum));
+			}
+			const bool IsDrained = Enumerator.ForwardForEach([&Enumerator, &Heap, &Greater, &Budget, Count](typename TEnumeratorSort::ElementType& Element)
+			{
+				if (Heap.Num() < Count)
+				{
+					Heap.HeapPush({{Enumerator.MakeKey(Element), Enumerator.Ordinal}, Enumerator.Elements.Num()}, Greater);
+					Enumerator.Elements.Add(Element);
+				}
+				else
+				{
+					KeyType Key = Enumerator.MakeKey(Element);
+					if (Key < Heap.HeapTop().Entry.Key)
+					{
+						const int Slot = Heap.HeapTop().Slot;
+						Heap.HeapPopDiscard(Greater);
+						Heap.HeapPush({{MoveTemp(Key), Enumerator.Ordinal}, Slot}, Greater);
+						Enumerator.Elements.Set(Slot, Element);
+					}
+				}
+				Enumerator.Ordinal += 1;
+				return Budget.Consume();
+			});
+			if (false == IsDrained)
+			{
+				return false;
+			}
+		}
+
+		Algo::Sort(Heap, [](const TTopEntry<KeyType>& L, const TTopEntry<KeyType>& R)
+		{
+			return SortEntryLess(L.Entry, R.Entry);
+		});
+		Enumerator.Sorted.Reserve(Heap.Num());
+		for (TTopEntry<KeyType>& Top : Heap)
+		{
+			Enumerator.Sorted.Add({MoveTemp(Top.Entry.Key), Top.Slot});
+		}
+		Heap.Reset();
+		return true;
+	}
+
+	// Every key selector of the OrderBy/ThenBy chain runs once per element; the sort only moves (key, index) entries.
+	// The gather and the radix passes of the sort can be spread over several calls by Budget.
+	template <typename TEnumeratorSort, typename TBudget>
+	bool GatherSorted(TEnumeratorSort& Enumerator, TBudget& Budget)
+	{
+#if LINQ_INSTRUMENTATION
+		TRACE_CPUPROFILER_EVENT_SCOPE(Linq_Sort);
+		FCycleScope CycleScope(Enumerator.StageCounter.Stats.Cycles);
+#endif
+		if (Enumerator.Ordinal == 0)
+		{
+			// An unknown upstream size (MaxNum 0) may still exceed TopCount, so only an exact small size skips the heap.
+			const int ForwardNum = Enumerator.ForwardMaxNum();
+			Enumerator.IsTopGather = Enumerator.TopCount >= 0 && false == (TEnumeratorSort::IsExactNum && ForwardNum <= Enumerator.TopCount);
+			if (false == Enumerator.IsTopGather)
+			{
+				const int Num = ForwardNum;
+				Enumerator.Elements.Reserve(Num);
+				Enumerator.Sorted.Reserve(Num);
+			}
+		}
+
+		if (Enumerator.IsTopGather)
+		{
+			if (false == GatherTopSorted(Enumerator, Enumerator.TopCount, Budget))
+			{
+				return false;
+			}
+		}
+		else
+		{
+			const bool IsDrained = Enumerator.ForwardForEach([&Enumerator, &Budget](typename TEnumeratorSort::ElementType& Element)
+			{
+				Enumerator.Sorted.Add({Enumerator.MakeKey(Element), Enumerator.Elements.Num()});
+				Enumerator.Elements.Add(Element);
+				Enumerator.Ordinal += 1;
+				return Budget.Consume();
+			});
+			if (false == IsDrained || false == SortEntries(Enumerator.Sorted, Enumerator.SortScratch, Enumerator.RadixPass, Budget))
+			{
+				return false;
+			}
+		}
+		Enumerator.IsGathered = true;
+#if LINQ_INSTRUMENTATION
+		Enumerator.StageCounter.Stats.ScratchBytes += Enumerator.Elements.Items.GetAllocatedSize() + Enumerator.Sorted.GetAllocatedSize() + Enumerator.SortScratch.GetAllocatedSize();
+#endif
+		return true;
+	}
+
+	template <typename TEnumeratorSort>
+	void GatherSorted(TEnumeratorSort& Enumerator)
+	{
+		// Only a Where charging a budgeted tick stops a gather without a budget of its own; resume until drained.
+		FUnlimitedBudget Budget;
+		while (false == GatherSorted(Enumerator, Budget))
+		{
+		}
+	}
+
+	template <typename TEnumeratorSort, typename TSink>
+	bool ForEachSorted(TEnumeratorSort& Enumerator, TSink& Sink)
+	{
+		if (false == Enumerator.IsGathered)
+		{
+			GatherSorted(Enumerator);
+		}
+		const int Num = Enumerator.Sorted.Num();
+		for (int Cursor = Enumerator.Index + 1; Cursor < Num; ++Cursor)
+		{
+			if (!Sink(Enumerator.Elements[Enumerator.Sorted[Cursor].Index]))
+			{
+#if LINQ_INSTRUMENTATION
+				Enumerator.StageCounter.Stats.Yielded += Cursor - Enumerator.Index;
+#endif
+				Enumerator.Index = Cursor;
+				return false;
+			}
+		}
+#if LINQ_INSTRUMENTATION
+		Enumerator.StageCounter.Stats.Yielded += Num - 1 - Enumerator.Index;
+#endif
+		Enumerator.Index = Num - 1;
+		return true;
+	}
+
+	struct IEnumeratorSort
+	{
+	};
+
+	template <typename TEnumerator, typename TPredicate, bool IsAscending, typename TAllocator = FDefaultAllocator>
+	struct TEnumeratorOrderBy : public IEnumeratorSort
+	{
+	public:
+		typedef typename TEnumerator::ElementType ElementType;
+		typedef TSortKey<std::decay_t<typename Lambda<TPredicate>::ReturnType>, IsAscending> KeyType;
+		static constexpr bool IsForwardStableReference = TEnumerator::IsStableReference;
+		TEnumerator Enumerator;
+		TPredicate Pred;
+		typedef TAllocator AllocatorType;
+		TElementBuffer<ElementType, IsForwardStableReference, TAllocator> Elements;
+		TArray<TSortEntry<KeyType>, TAllocator> Sorted;
+		TArray<TSortEntry<KeyType>, TAllocator> SortScratch;
+		TArray<TTopEntry<KeyType>, TAllocator> TopHeap;
+		int TopCount = -1;
+		int Index = -1;
+		int Ordinal = 0;
+		int RadixPass = 0;
+		bool IsTopGather = false;
+		bool IsGathered = false;
+		LINQ_STAGE_COUNTER("OrderBy")
+
+		TEnumeratorOrderBy(TEnumerator&& Enumerator, TPredicate&& Pred, int TopCount = -1) : Enumerator(MoveTemp(Enumerator)), Pred(Forward<TPredicate>(Pred)), TopCount(TopCount)
+		{
+		}
+
+		KeyType MakeKey(ElementType& Element)
+		{
+			LINQ_COUNT(Pulled, 1);
+			LINQ_COUNT(PredicateCalls, 1);
+			return KeyType(Pred(Element));
+		}
+
+		template <typename TSink>
+		bool ForwardForEach(TSink&& Sink)
+		{
+			return Enumerator.ForEach(Sink);
+		}
+
+		template <typename TBudget>
+		bool ForwardPrepare(TBudget& Budget)
+		{
+			return Linq::Prepare(Enumerator, Budget);
+		}
+
+		// The size of the unsorted upstream, before any TopCount limit of this chain.
+		int ForwardMaxNum() const
+		{
+			return Enumerator.MaxNum();
+		}
+
+		bool MoveNext()
+		{
+			if (false == IsGathered)
+			{
+				GatherSorted(*this);
+			}
+
+			if (Index < Sorted.Num() - 1)
+			{
+				LINQ_COUNT(Yielded, 1);
+				Index += 1;
+				return true;
+			}
+			return false;
+		}
+
+		ElementType& Current()
+		{
+			return Elements[Sorted[Index].Index];
+		}
+
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			return ForEachSorted(*this, Sink);
+		}
+
+		static constexpr bool IsExactNum = TEnumerator::IsExactNum;
+		static constexpr bool IsStableReference = true;
+
+		int MaxNum() const
+		{
+			if (false == IsGathered)
+			{
+				const int ForwardNum = ForwardMaxNum();
+				if (false == IsExactNum && ForwardNum == 0)
+				{
+					return FMath::Max(TopCount, 0);
+				}
+				const int Num = ForwardNum + Ordinal;
+				return TopCount >= 0 && TopCount < Num ? TopCount : Num;
+			}
+			return Sorted.Num() - Index - 1;
+		}
+
+		template <typename TBudget>
+		bool Prepare(TBudget& Budget)
+		{
+			return IsGathered || (ForwardPrepare(Budget) && GatherSorted(*this, Budget));
+		}
+
+		template <typename TSource>
+		TEnumeratorRef<TEnumeratorOrderBy> Rebind(TSource& Source)
+		{
+			Enumerator.Rebind(Source);
+			Elements.Reset();
+			Sorted.Reset();
+			TopHeap.Reset();
+			Index = -1;
+			Ordinal = 0;
+			RadixPass = 0;
+			IsGathered = false;
+			return TEnumeratorRef<TEnumeratorOrderBy>(*this);
+		}
+
+		template <typename TSource>
+		void Rebind(TSource&& Source) = delete;
+
+		template <typename TGenerator>
+		auto operator>>(TGenerator Generator)
+		{
+			return Generator.Gen(*this);
+		}
+	};
+
+	template <typename TEnumerator, typename TPredicate, bool IsAscending, typename TAllocator = FDefaultAllocator>
+	struct TEnumeratorThenBy : public IEnumeratorSort
+	{
+	public:
+		static_assert(std::is_convertible<TEnumerator, IEnumeratorSort>::value, "ThenBy must follow OrderBy or ThenBy");
+		typedef typename TEnumerator::ElementType ElementType;
+		typedef TSortKeyThen<typename TEnumerator::KeyType, TSortKey<std::decay_t<typename Lambda<TPredicate>::ReturnType>, IsAscending>> KeyType;
+		static constexpr bool IsForwardStableReference = TEnumerator::IsForwardStableReference;
+		TEnumerator Enumerator;
+		TPredicate Pred;
+		typedef TAllocator AllocatorType;
+		TElementBuffer<ElementType, IsForwardStableReference, TAllocator> Elements;
+		TArray<TSortEntry<KeyType>, TAllocator> Sorted;
+		TArray<TSortEntry<KeyType>, TAllocator> SortScratch;
+		TArray<TTopEntry<KeyType>, TAllocator> TopHeap;
+		int TopCount = -1;
+		int Index = -1;
+		int Ordinal = 0;
+		int RadixPass = 0;
+		bool IsTopGather = false;
+		bool IsGathered = false;
+		LINQ_STAGE_COUNTER("ThenBy")
+
+		TEnumeratorThenBy(TEnumerator&& Enumerator, TPredicate&& Pred) : Enumerator(MoveTemp(Enumerator)), Pred(Forward<TPredicate>(Pred)), TopCount(this->Enumerator.TopCount)
+		{
+		}
+
+		KeyType MakeKey(ElementType& Element)
+		{
+			LINQ_COUNT(Pulled, 1);
+			LINQ_COUNT(PredicateCalls, 1);
+			return KeyType(Enumerator.MakeKey(Element), Pred(Element));
+		}
+
+		template <typename TSink>
+		bool ForwardForEach(TSink&& Sink)
+		{
+			return Enumerator.ForwardForEach(Sink);
+		}
+
+		template <typename TBudget>
+		bool ForwardPrepare(TBudget& Budget)
+		{
+			return Enumerator.ForwardPrepare(Budget);
+		}
+
+		int ForwardMaxNum() const
+		{
+			return Enumerator.ForwardMaxNum();
+		}
+
+		bool MoveNext()
+		{
+			if (false == IsGathered)
+			{
+				GatherSorted(*this);
+			}
+
+			if (Index < Sorted.Num() - 1)
+			{
+				LINQ_COUNT(Yielded, 1);
+				Index += 1;
+				return true;
+			}
+			return false;
+		}
+
+		ElementType& Current()
+		{
+			return Elements[Sorted[Index].Index];
+		}
+
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			return ForEachSorted(*this, Sink);
+		}
+
+		static constexpr bool IsExactNum = TEnumerator::IsExactNum;
+		static constexpr bool IsStableReference = true;
+
+		int MaxNum() const
+		{
+			if (false == IsGathered)
+			{
+				const int ForwardNum = ForwardMaxNum();
+				if (false == IsExactNum && ForwardNum == 0)
+				{
+					return FMath::Max(TopCount, 0);
+				}
+				const int Num = ForwardNum + Ordinal;
+				return TopCount >= 0 && TopCount < Num ? TopCount : Num;
+			}
+			return Sorted.Num() - Index - 1;
+		}
+
+		template <typename TBudget>
+		bool Prepare(TBudget& Budget)
+		{
+			return IsGathered || (ForwardPrepare(Budget) && GatherSorted(*this, Budget));
+		}
+
+		template <typename TSource>
+		TEnumeratorRef<TEnumeratorThenBy> Rebind(TSource& Source)
+		{
+			Enumerator.Rebind(Source);
+			Elements.Reset();
+			Sorted.Reset();
+			TopHeap.Reset();
+			Index = -1;
+			Ordinal = 0;
+			RadixPass = 0;
+			IsGathered = false;
+			return TEnumeratorRef<TEnumeratorThenBy>(*this);
+		}
+
+		template <typename TSource>
+		void Rebind(TSource&& Source) = delete;
+
+		template <typename TGenerator>
+		auto operator>>(TGenerator Generator)
+		{
+			return Generator.Gen(*this);
+		}
+	};
+
+	template <typename TPredicate, typename TAllocator = FDefaultAllocator>
+	struct TGeneratorOrderBy
+	{
+	public:
+		TPredicate Pred;
+
+		TGeneratorOrderBy(TPredicate&& Pred) : Pred(Forward<TPredicate>(Pred))
+		{
+		}
+
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			return TEnumeratorOrderBy<TEnumerator, TPredicate, true, TAllocator>(MoveTemp(Enumerator), Forward<TPredicate>(Pred));
+		}
+	};
+
+	template <typename TPredicate, typename TAllocator = FDefaultAllocator>
+	struct TGeneratorTopBy
+	{
+	public:
+		int Count;
+		TPredicate Pred;
+
+		TGeneratorTopBy(int Count, TPredicate&& Pred) : Count(Count), Pred(Forward<TPredicate>(Pred))
+		{
+		}
+
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			return TEnumeratorOrderBy<TEnumerator, TPredicate, true, TAllocator>(MoveTemp(Enumerator), Forward<TPredicate>(Pred), FMath::Max(Count, 0));
+		}
+	};
+
+	template <typename TPredicate, typename TAllocator = FDefaultAllocator>
+	struct TGeneratorThenBy
+	{
+	public:
+		TPredicate Pred;
+
+		TGeneratorThenBy(TPredicate&& Pred) : Pred(Forward<TPredicate>(Pred))
+		{
+		}
+
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			return TEnumeratorThenBy<TEnumerator, TPredicate, true, TAllocator>(MoveTemp(Enumerator), Forward<TPredicate>(Pred));
+		}
+	};
+
+	template <typename TEnumerator, typename TAllocator = FDefaultAllocator>
+	struct TEnumeratorReverse
+	{
+		TEnumerator Enumerator;
+		typedef typename TEnumerator::ElementType ElementType;
+		// Random-access sources are walked backwards in place; everything else is buffered once.
+		static constexpr bool IsForwardRandomAccess = TIsRandomAccess<TEnumerator>::Value;
+		TElementBuffer<ElementType, TEnumerator::IsStableReference, TAllocator> Reversed;
+		int Index = 0;
+		bool IsStarted = false;
+		LINQ_STAGE_COUNTER("Reverse")
+
+		TEnumeratorReverse(TEnumerator&& Enumerator) : Enumerator(MoveTemp(Enumerator))
+		{
+		}
+
+		template <typename TBudget>
+		bool Prepare(TBudget& Budget)
+		{
+			if (IsStarted)
+			{
+				return true;
+			}
+			if (false == Linq::Prepare(Enumerator, Budget))
+			{
+				return false;
+			}
+			if constexpr (IsForwardRandomAccess)
+			{
+				Index = Enumerator.MaxNum();
+			}
+			else
+			{
+				LINQ_TRACE_SCOPE(Linq_Reverse);
+				LINQ_CYCLE_SCOPE();
+				if (Reversed.Num() == 0)
+				{
+					Reversed.Reserve(Enumerator.MaxNum());
+				}
+				const bool IsDrained = Enumerator.ForEach([this, &Budget](ElementType& Element)
+				{
+					LINQ_COUNT(Pulled, 1);
+					Reversed.Add(Element);
+					return Budget.Consume();
+				});
+				if (false == IsDrained)
+				{
+					return false;
+				}
+				Index = Reversed.Num();
+				LINQ_COUNT(ScratchBytes, Reversed.Items.GetAllocatedSize());
+			}
+			IsStarted = true;
+			return true;
+		}
+
+		void Start()
+		{
+			FUnlimitedBudget Budget;
+			while (false == Prepare(Budget))
+			{
+			}
+		}
+
+		bool MoveNext()
+		{
+			if (false == IsStarted)
+			{
+				Start();
+			}
+
+			if (Index > 0)
+			{
+				LINQ_COUNT(Yielded, 1);
+				Index -= 1;
+				return true;
+			}
+			return false;
+		}
+
+		ElementType& Current()
+		{
+			if constexpr (IsForwardRandomAccess)
+			{
+				return Enumerator.ElementAt(Index);
+			}
+			else
+			{
+				return Reversed[Index];
+			}
+		}
+
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			while (MoveNext())
+			{
+				if (!Sink(Current()))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		static constexpr bool IsExactNum = TEnumerator::IsExactNum;
+		static constexpr bool IsStableReference = IsForwardRandomAccess ? TEnumerator::IsStableReference : true;
+		static constexpr bool IsRandomAccess = IsForwardRandomAccess;
+
+		int MaxNum() const
+		{
+			return IsStarted ? Index : Enumerator.MaxNum() + Reversed.Num();
+		}
+
+		ElementType& ElementAt(int Offset)
+		{
+			if (false == IsStarted)
+			{
+				Start();
+			}
+			return Enumerator.ElementAt(Index - 1 - Offset);
+		}
+
+		void Advance(int Count)
+		{
+			if (false == IsStarted)
+			{
+				Start();
+			}
+			Index = FMath::Max(Index - Count, 0);
+		}
+
+		template <typename TSource>
+		TEnumeratorRef<TEnumeratorReverse> Rebind(TSource& Source)
+		{
+			Enumerator.Rebind(Source);
+			Reversed.Reset();
+			Index = 0;
+			IsStarted = false;
+			return TEnumeratorRef<TEnumeratorReverse>(*this);
+		}
+
+		template <typename TSource>
+		void Rebind(TSource&& Source) = delete;
+
+		template <typename TGenerator>
+		auto operator>>(TGenerator Generator)
+		{
+			return Generator.Gen(*this);
+		}
+	};
+
+	template <typename TAllocator = FDefaultAllocator>
+	struct TGeneratorReverse
+	{
+	public:
+		TGeneratorReverse()
+		{
+		}
+
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			return TEnumeratorReverse<TEnumerator, TAllocator>(MoveTemp(Enumerator));
+		}
+	};
+
+	template <typename TEnumerator>
+	struct TEnumeratorTake
+	{
+	public:
+		typedef typename TEnumerator::ElementType ElementType;
+		TEnumerator Enumerator;
+		int TakeCount;
+		int Remaining;
+		LINQ_STAGE_COUNTER("Take")
+
+		TEnumeratorTake(TEnumerator&& Enumerator, int Count) : Enumerator(MoveTemp(Enumerator)), TakeCount(FMath::Max(Count, 0)), Remaining(TakeCount)
+		{
+		}
+
+		bool MoveNext()
+		{
+			if (Remaining > 0 && Enumerator.MoveNext())
+			{
+				LINQ_COUNT(Pulled, 1);
+				LINQ_COUNT(Yielded, 1);
+				Remaining -= 1;
+				return true;
+			}
+			Remaining = 0;
+			return false;
+		}
+
+		ElementType& Current()
+		{
+			return Enumerator.Current();
+		}
+
+		// The upstream is never asked for an element past the limit, so its predicates do not run there.
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			if (Remaining <= 0)
+			{
+				return true;
+			}
+			bool IsSinkStopped = false;
+			const bool IsDrained = Enumerator.ForEach([this, &Sink, &IsSinkStopped](ElementType& Element)
+			{
+				LINQ_COUNT(Pulled, 1);
+				LINQ_COUNT(Yielded, 1);
+				Remaining -= 1;
+				IsSinkStopped = !Sink(Element);
+				return !IsSinkStopped && Remaining > 0;
+			});
+			// The upstream can also stop on its own when a budgeted tick runs out; that is not the end.
+			return !IsSinkStopped && (IsDrained || Remaining <= 0);
+		}
+
+		static constexpr bool IsExactNum = TEnumerator::IsExactNum;
+		static constexpr bool IsStableReference = TEnumerator::IsStableReference;
+		static constexpr bool IsRandomAccess = TIsRandomAccess<TEnumerator>::Value;
+
+		int MaxNum() const
+		{
+			return FMath::Min(Enumerator.MaxNum(), Remaining);
+		}
+
+		ElementType& ElementAt(int Offset)
+		{
+			return Enumerator.ElementAt(Offset);
+		}
+
+		void Advance(int Count)
+		{
+			Count = FMath::Min(Count, Remaining);
+			Enumerator.Advance(Count);
+			Remaining -= Count;
+		}
+
+		template <typename TSource>
+		TEnumeratorRef<TEnumeratorTake> Rebind(TSource& Source)
+		{
+			Enumerator.Rebind(Source);
+			Remaining = TakeCount;
+			return TEnumeratorRef<TEnumeratorTake>(*this);
+		}
+
+		template <typename TSource>
+		void Rebind(TSource&& Source) = delete;
+
+		template <typename TGenerator>
+		auto operator>>(TGenerator Generator)
+		{
+			return Generator.Gen(*this);
+		}
+	};
+
+	template <typename TEnumerator>
+	struct TEnumeratorSkip
+	{
+	public:
+		typedef typename TEnumerator::ElementType ElementType;
+		TEnumerator Enumerator;
+		int InitialSkipCount;
+		int SkipCount;
+		LINQ_STAGE_COUNTER("Skip")
+
+		TEnumeratorSkip(TEnumerator&& Enumerator, int Count) : Enumerator(MoveTemp(Enumerator)), InitialSkipCount(FMath::Max(Count, 0)), SkipCount(InitialSkipCount)
+		{
+		}
+
+		// Random-access sources jump over the skipped range; others are pulled through it once.
+		void Start()
+		{
+			if constexpr (TIsRandomAccess<TEnumerator>::Value)
+			{
+				Enumerator.Advance(SkipCount);
+			}
+			else
+			{
+				while (SkipCount > 0 && Enumerator.MoveNext())
+				{
+					LINQ_COUNT(Pulled, 1);
+					SkipCount -= 1;
+				}
+			}
+			SkipCount = 0;
+		}
+
+		bool MoveNext()
+		{
+			if (SkipCount > 0)
+			{
+				Start();
+			}
+			return Enumerator.MoveNext();
+		}
+
+		ElementType& Current()
+		{
+			return Enumerator.Current();
+		}
+
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			if (SkipCount > 0)
+			{
+				Start();
+			}
+			return Enumerator.ForEach(Sink);
+		}
+
+		static constexpr bool IsBatched = TIsBatched<TEnumerator>::Value;
+
+		const ElementType* NextBatch(ElementType* Scratch, int& Num)
+		{
+			if (SkipCount > 0)
+			{
+				Start();
+			}
+			return Enumerator.NextBatch(Scratch, Num);
+		}
+
+		static constexpr bool IsExactNum = TEnumerator::IsExactNum;
+		static constexpr bool IsStableReference = TEnumerator::IsStableReference;
+		static constexpr bool IsRandomAccess = TIsRandomAccess<TEnumerator>::Value;
+
+		int MaxNum() const
+		{
+			return FMath::Max(Enumerator.MaxNum() - SkipCount, 0);
+		}
+
+		ElementType& ElementAt(int Offset)
+		{
+			if (SkipCount > 0)
+			{
+				Start();
+			}
+			return Enumerator.ElementAt(Offset);
+		}
+
+		void Advance(int Count)
+		{
+			SkipCount += Count;
+			Start();
+		}
+
+		template <typename TSource>
+		TEnumeratorRef<TEnumeratorSkip> Rebind(TSource& Source)
+		{
+			Enumerator.Rebind(Source);
+			SkipCount = InitialSkipCount;
+			return TEnumeratorRef<TEnumeratorSkip>(*this);
+		}
+
+		template <typename TSource>
+		void Rebind(TSource&& Source) = delete;
+
+		template <typename TGenerator>
+		auto operator>>(TGenerator Generator)
+		{
+			return Generator.Gen(*this);
+		}
+	};
+
+	// Take over an unstarted OrderBy/ThenBy (optionally behind a Skip) only needs the first Count sorted elements.
+	template <typename TEnumerator>
+	void LimitTop(TEnumerator& Enumerator, int Count)
+	{
+		if constexpr (std::is_convertible<TEnumerator, IEnumeratorSort>::value)
+		{
+			if (Enumerator.Index == -1 && (Enumerator.TopCount < 0 || Count < Enumerator.TopCount))
+			{
+				Enumerator.TopCount = Count;
+			}
+		}
+	}
+
+	// The limit does not depend on MaxNum, so it also applies to sources of unknown size and Query<T>() pipelines.
+	template <typename TEnumerator>
+	void LimitTop(TEnumeratorSkip<TEnumerator>& Enumerator, int Count)
+	{
+		LimitTop(Enumerator.Enumerator, Count > MAX_int32 - Enumerator.SkipCount ? MAX_int32 : Enumerator.SkipCount + Count);
+	}
+
+	struct TGeneratorTake
+	{
+	public:
+		int Count;
+
+		TGeneratorTake(int Count) : Count(Count)
+		{
+		}
+
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			LimitTop(Enumerator, FMath::Max(Count, 0));
+			return TEnumeratorTake<TEnumerator>(MoveTemp(Enumerator), Count);
+		}
+	};
+
+	struct TGeneratorSkip
+	{
+	public:
+		int Count;
+
+		TGeneratorSkip(int Count) : Count(Count)
+		{
+		}
+
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			return TEnumeratorSkip<TEnumerator>(MoveTemp(Enumerator), Count);
+		}
+	};
+
+	template <typename TEnumerator, typename TPredicate>
+	struct TEnumeratorTakeWhile
+	{
+	public:
+		typedef typename TEnumerator::ElementType ElementType;
+		TEnumerator Enumerator;
+		TPredicate Pred;
+		bool IsDone = false;
+		LINQ_STAGE_COUNTER("TakeWhile")
+
+		TEnumeratorTakeWhile(TEnumerator&& Enumerator, TPredicate&& Pred) : Enumerator(MoveTemp(Enumerator)), Pred(Forward<TPredicate>(Pred))
+		{
+		}
+
+		bool MoveNext()
+		{
+			if (false == IsDone && Enumerator.MoveNext() && (LINQ_COUNT(Pulled, 1), LINQ_CALL(Pred(Enumerator.Current()))))
+			{
+				LINQ_COUNT(Yielded, 1);
+				return true;
+			}
+			IsDone = true;
+			return false;
+		}
+
+		ElementType& Current()
+		{
+			return Enumerator.Current();
+		}
+
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			if (IsDone)
+			{
+				return true;
+			}
+			bool IsSinkStopped = false;
+			const bool IsDrained = Enumerator.ForEach([this, &Sink, &IsSinkStopped](ElementType& Element)
+			{
+				LINQ_COUNT(Pulled, 1);
+				if (!LINQ_CALL(Pred(Element)))
+				{
+					IsDone = true;
+					return false;
+				}
+				LINQ_COUNT(Yielded, 1);
+				IsSinkStopped = !Sink(Element);
+				return !IsSinkStopped;
+			});
+			return !IsSinkStopped && (IsDrained || IsDone);
+		}
+
+		static constexpr bool IsExactNum = false;
+		static constexpr bool IsStableReference = TEnumerator::IsStableReference;
+
+		int MaxNum() const
+		{
+			return IsDone ? 0 : Enumerator.MaxNum();
+		}
+
+		template <typename TSource>
+		TEnumeratorRef<TEnumeratorTakeWhile> Rebind(TSource& Source)
+		{
+			Enumerator.Rebind(Source);
+			IsDone = false;
+			return TEnumeratorRef<TEnumeratorTakeWhile>(*this);
+		}
+
+		template <typename TSource>
+		void Rebind(TSource&& Source) = delete;
+
+		template <typename TGenerator>
+		auto operator>>(TGenerator Generator)
+		{
+			return Generator.Gen(*this);
+		}
+	};
+
+	template <typename TEnumerator, typename TPredicate>
+	struct TEnumeratorSkipWhile
+	{
+	public:
+		typedef typename TEnumerator::ElementType ElementType;
+		TEnumerator Enumerator;
+		TPredicate Pred;
+		bool IsSkipping = true;
+		LINQ_STAGE_COUNTER("SkipWhile")
+
+		TEnumeratorSkipWhile(TEnumerator&& Enumerator, TPredicate&& Pred) : Enumerator(MoveTemp(Enumerator)), Pred(Forward<TPredicate>(Pred))
+		{
+		}
+
+		bool MoveNext()
+		{
+			while (Enumerator.MoveNext())
+			{
+				LINQ_COUNT(Pulled, 1);
+				if (IsSkipping && LINQ_CALL(Pred(Enumerator.Current())))
+				{
+					continue;
+				}
+				LINQ_COUNT(Yielded, 1);
+				IsSkipping = false;
+				return true;
+			}
+			return false;
+		}
+
+		ElementType& Current()
+		{
+			return Enumerator.Current();
+		}
+
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			return Enumerator.ForEach([this, &Sink](ElementType& Element)
+			{
+				LINQ_COUNT(Pulled, 1);
+				if (IsSkipping)
+				{
+					if (LINQ_CALL(Pred(Element)))
+					{
+						return true;
+					}
+					IsSkipping = false;
+				}
+				LINQ_COUNT(Yielded, 1);
+				return Sink(Element);
+			});
+		}
+
+		static constexpr bool IsExactNum = false;
+		static constexpr bool IsStableReference = TEnumerator::IsStableReference;
+
+		int MaxNum() const
+		{
+			return Enumerator.MaxNum();
+		}
+
+		template <typename TSource>
+		TEnumeratorRef<TEnumeratorSkipWhile> Rebind(TSource& Source)
+		{
+			Enumerator.Rebind(Source);
+			IsSkipping = true;
+			return TEnumeratorRef<TEnumeratorSkipWhile>(*this);
+		}
+
+		template <typename TSource>
+		void Rebind(TSource&& Source) = delete;
+
+		template <typename TGenerator>
+		auto operator>>(TGenerator Generator)
+		{
+			return Generator.Gen(*this);
+		}
+	};
+
+	template <typename TPredicate>
+	struct TGeneratorTakeWhile
+	{
+	public:
+		TPredicate Pred;
+
+		TGeneratorTakeWhile(TPredicate&& Pred) : Pred(Forward<TPredicate>(Pred))
+		{
+		}
+
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			return TEnumeratorTakeWhile<TEnumerator, TPredicate>(MoveTemp(Enumerator), Forward<TPredicate>(Pred));
+		}
+	};
+
+	template <typename TPredicate>
+	struct TGeneratorSkipWhile
+	{
+	public:
+		TPredicate Pred;
+
+		TGeneratorSkipWhile(TPredicate&& Pred) : Pred(Forward<TPredicate>(Pred))
+		{
+		}
+
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			return TEnumeratorSkipWhile<TEnumerator, TPredicate>(MoveTemp(Enumerator), Forward<TPredicate>(Pred));
+		}
+	};
+
+	template <typename TEnumerator, typename TPredicate, typename TSetAllocator = FDefaultSetAllocator>
+	struct TEnumeratorDistinctBy
+	{
+	public:
+		typedef typename TEnumerator::ElementType ElementType;
+		typedef typename Lambda<TPredicate>::ReturnType KeySelectorType;
+		TEnumerator Enumerator;
+		TPredicate Pred;
+		TSet<KeySelectorType, DefaultKeyFuncs<KeySelectorType>, TSetAllocator> Keys;
+		LINQ_STAGE_COUNTER("DistinctBy")
+
+		TEnumeratorDistinctBy(TEnumerator&& Enumerator, TPredicate&& Pred, int Capacity) : Enumerator(MoveTemp(Enumerator)), Pred(Forward<TPredicate>(Pred))
+		{
+			Keys.Reserve(Capacity);
+		}
+
+		bool IsFirstSeen(ElementType& Element)
+		{
+			bool IsAlreadyInSet;
+			LINQ_COUNT(Pulled, 1);
+			Keys.Emplace(LINQ_CALL(Pred(Element)), &IsAlreadyInSet);
+			LINQ_COUNT(Yielded, IsAlreadyInSet ? 0 : 1);
+			return !IsAlreadyInSet;
+		}
+
+		bool MoveNext()
+		{
+			while (Enumerator.MoveNext())
+			{
+				if (IsFirstSeen(Enumerator.Current()))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		ElementType& Current()
+		{
+			return Enumerator.Current();
+		}
+
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			return Enumerator.ForEach([this, &Sink](ElementType& Element)
+			{
+				return !IsFirstSeen(Element) || Sink(Element);
+			});
+		}
+
+		static constexpr bool IsExactNum = false;
+		static constexpr bool IsStableReference = TEnumerator::IsStableReference;
+
+		int MaxNum() const
+		{
+			return Enumerator.MaxNum();
+		}
+
+		template <typename TSource>
+		TEnumeratorRef<TEnumeratorDistinctBy> Rebind(TSource& Source)
+		{
+			Enumerator.Rebind(Source);
+			Keys.Reset();
+			return TEnumeratorRef<TEnumeratorDistinctBy>(*this);
+		}
+
+		template <typename TSource>
+		void Rebind(TSource&& Source) = delete;
+
+		template <typename TGenerator>
+		auto operator>>(TGenerator Generator)
+		{
+			return Generator.Gen(*this);
+		}
+	};
+
+	template <typename TPredicate, typename TSetAllocator = FDefaultSetAllocator>
+	struct TGeneratorDistinctBy
+	{
+	public:
+		TPredicate Pred;
+		int Capacity;
+
+		TGeneratorDistinctBy(TPredicate&& Pred, int Capacity) : Pred(Forward<TPredicate>(Pred)), Capacity(Capacity)
+		{
+		}
+
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			return TEnumeratorDistinctBy<TEnumerator, TPredicate, TSetAllocator>(MoveTemp(Enumerator), Forward<TPredicate>(Pred), Capacity);
+		}
+	};
+
+	template <typename TKeyType, typename TElementType, bool IsStableReference, typename TAllocator = FDefaultAllocator>
+	struct TGrouping
+	{
+	public:
+		TKeyType Key;
+		TElementBuffer<TElementType, IsStableReference, TAllocator> Elements;
+
+		TGrouping(const TKeyType& Key) : Key(Key)
+		{
+		}
+
+		int Num() const
+		{
+			return Elements.Num();
+		}
+
+		TElementType& operator[](int Index)
+		{
+			return Elements[Index];
+		}
+	};
+
+	template <typename TEnumerator, typename TPredicate, typename TAllocator = FDefaultAllocator, typename TSetAllocator = FDefaultSetAllocator>
+	struct TEnumeratorGroupBy
+	{
+	public:
+		typedef std::decay_t<typename Lambda<TPredicate>::ReturnType> KeySelectorType;
+		typedef TGrouping<KeySelectorType, typename TEnumerator::ElementType, TEnumerator::IsStableReference, TAllocator> ElementType;
+		TEnumerator Enumerator;
+		TPredicate Pred;
+		// Groups past GroupNum are left over from an earlier Rebind run and keep their element buffers for reuse.
+		TArray<ElementType, TAllocator> Groups;
+		TMap<KeySelectorType, int, TSetAllocator> GroupIndices;
+		int GroupNum = 0;
+		int Index = -1;
+		bool IsGathered = false;
+		LINQ_STAGE_COUNTER("GroupBy")
+
+		TEnumeratorGroupBy(TEnumerator&& Enumerator, TPredicate&& Pred) : Enumerator(MoveTemp(Enumerator)), Pred(Forward<TPredicate>(Pred))
+		{
+		}
+
+		template <typename TBudget>
+		bool Prepare(TBudget& Budget)
+		{
+			if (IsGathered)
+			{
+				return true;
+			}
+			if (false == Linq::Prepare(Enumerator, Budget))
+			{
+				return false;
+			}
+			LINQ_TRACE_SCOPE(Linq_GroupBy);
+			const bool IsDrained = Enumerator.ForEach([this, &Budget](typename TEnumerator::ElementType& Element)
+			{
+				LINQ_COUNT(Pulled, 1);
+				KeySelectorType Key = LINQ_CALL(Pred(Element));
+				int* GroupIndex = GroupIndices.Find(Key);
+				if (GroupIndex == nullptr)
+				{
+					GroupIndex = &GroupIndices.Add(Key, GroupNum);
+					if (GroupNum < Groups.Num())
+					{
+						Groups[GroupNum].Key = Key;
+					}
+					else
+					{
+						Groups.Emplace(Key);
+					}
+					GroupNum += 1;
+				}
+				Groups[*GroupIndex].Elements.Add(Element);
+				return Budget.Consume();
+			});
+			if (false == IsDrained)
+			{
+				return false;
+			}
+			IsGathered = true;
+#if LINQ_INSTRUMENTATION
+			StageCounter.Stats.ScratchBytes += GroupIndices.GetAllocatedSize() + Groups.GetAllocatedSize();
+			for (ElementType& Group : Groups)
+			{
+				StageCounter.Stats.ScratchBytes += Group.Elements.Items.GetAllocatedSize();
+			}
+#endif
+			return true;
+		}
+
+		void Gather()
+		{
+			FUnlimitedBudget Budget;
+			while (false == Prepare(Budget))
+			{
+			}
+		}
+
+		bool MoveNext()
+		{
+			if (false == IsGathered)
+			{
+				Gather();
+			}
+
+			if (Index < GroupNum - 1)
+			{
+				LINQ_COUNT(Yielded, 1);
+				Index += 1;
+				return true;
+			}
+			return false;
+		}
+
+		ElementType& Current()
+		{
+			return Groups[Index];
+		}
+
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			if (false == IsGathered)
+			{
+				Gather();
+			}
+			const int Num = GroupNum;
+			for (int Cursor = Index + 1; Cursor < Num; ++Cursor)
+			{
+				if (!Sink(Groups[Cursor]))
+				{
+					LINQ_COUNT(Yielded, Cursor - Index);
+					Index = Cursor;
+					return false;
+				}
+			}
+			LINQ_COUNT(Yielded, Num - 1 - Index);
+			Index = Num - 1;
+			return true;
+		}
+
+		static constexpr bool IsExactNum = false;
+		static constexpr bool IsStableReference = true;
+
+		int MaxNum() const
+		{
+			return IsGathered ? GroupNum - Index - 1 : Enumerator.MaxNum() + GroupNum;
+		}
+
+		template <typename TSource>
+		TEnumeratorRef<TEnumeratorGroupBy> Rebind(TSource& Source)
+		{
+			Enumerator.Rebind(Source);
+			for (int Group = 0; Group < GroupNum; ++Group)
+			{
+				Groups[Group].Elements.Reset();
+			}
+			GroupNum = 0;
+			GroupIndices.Reset();
+			Index = -1;
+			IsGathered = false;
+			return TEnumeratorRef<TEnumeratorGroupBy>(*this);
+		}
+
+		template <typename TSource>
+		void Rebind(TSource&& Source) = delete;
+
+		template <typename TGenerator>
+		auto operator>>(TGenerator Generator)
+		{
+			return Generator.Gen(*this);
+		}
+	};
+
+	template <typename TPredicate, typename TAllocator = FDefaultAllocator, typename TSetAllocator = FDefaultSetAllocator>
+	struct TGeneratorGroupBy
+	{
+	public:
+		TPredicate Pred;
+
+		TGeneratorGroupBy(TPredicate&& Pred) : Pred(Forward<TPredicate>(Pred))
+		{
+		}
+
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			return TEnumeratorGroupBy<TEnumerator, TPredicate, TAllocator, TSetAllocator>(MoveTemp(Enumerator), Forward<TPredicate>(Pred));
+		}
+	};
+
+	template <typename TEnumerator, typename TEnumeratorKey, typename TPredicate, bool IsIntersect, typename TSetAllocator = FDefaultSetAllocator>
+	struct TEnumeratorKeySetBy
+	{
+	public:
+		typedef typename TEnumerator::ElementType ElementType;
+		typedef typename TEnumeratorKey::ElementType ElementKeyType;
+		TEnumerator Enumerator;
+		TEnumeratorKey Key;
+		TPredicate Pred;
+		TSet<ElementKeyType, DefaultKeyFuncs<ElementKeyType>, TSetAllocator> Keys;
+		bool MoveStart = false;
+#if LINQ_INSTRUMENTATION
+		FStageCounter StageCounter{IsIntersect ? TEXT("IntersectBy") : TEXT("ExceptBy")};
+#endif
+
+		TEnumeratorKeySetBy(TEnumerator&& Enumerator, TEnumeratorKey&& Key, TPredicate&& Pred) : Enumerator(MoveTemp(Enumerator)), Key(Forward<TEnumeratorKey>(Key)), Pred(Forward<TPredicate>(Pred))
+		{
+		}
+
+		template <typename TBudget>
+		bool Prepare(TBudget& Budget)
+		{
+			if (false == MoveStart)
+			{
+				if (false == Linq::Prepare(Key, Budget))
+				{
+					return false;
+				}
+				if (Keys.Num() == 0)
+				{
+					Keys.Reserve(Key.MaxNum());
+				}
+				const bool IsDrained = Key.ForEach([this, &Budget](ElementKeyType& Value)
+				{
+					Keys.Emplace(Value);
+					return Budget.Consume();
+				});
+				if (false == IsDrained)
+				{
+					return false;
+				}
+				LINQ_COUNT(ScratchBytes, Keys.GetAllocatedSize());
+				MoveStart = true;
+			}
+			return Linq::Prepare(Enumerator, Budget);
+		}
+
+		void Gather()
+		{
+			FUnlimitedBudget Budget;
+			while (false == Prepare(Budget))
+			{
+			}
+		}
+
+		bool MoveNext()
+		{
+			if (false == MoveStart)
+			{
+				Gather();
+			}
+
+			while (Enumerator.MoveNext())
+			{
+				LINQ_COUNT(Pulled, 1);
+				if (Keys.Contains(LINQ_CALL(Pred(Enumerator.Current()))) == IsIntersect)
+				{
+					LINQ_COUNT(Yielded, 1);
+					return true;
+				}
+			}
+			return false;
+		}
+
+		ElementType& Current()
+		{
+			return Enumerator.Current();
+		}
+
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			if (false == MoveStart)
+			{
+				Gather();
+			}
+
+			return Enumerator.ForEach([this, &Sink](ElementType& Element)
+			{
+				LINQ_COUNT(Pulled, 1);
+				if (Keys.Contains(LINQ_CALL(Pred(Element))) != IsIntersect)
+				{
+					return true;
+				}
+				LINQ_COUNT(Yielded, 1);
+				return Sink(Element);
+			});
+		}
+
+		static constexpr bool IsExactNum = false;
+		static constexpr bool IsStableReference = TEnumerator::IsStableReference;
+
+		int MaxNum() const
+		{
+			return Enumerator.MaxNum();
+		}
+
+		template <typename TGenerator>
+		auto operator>>(TGenerator Generator)
+		{
+			return Generator.Gen(*this);
+		}
+	};
+
+	template <typename TEnumerator, typename TEnumeratorKey, typename TPredicate, typename TSetAllocator = FDefaultSetAllocator>
+	using TEnumeratorExceptBy = TEnumeratorKeySetBy<TEnumerator, TEnumeratorKey, TPredicate, false, TSetAllocator>;
+
+	template <typename TEnumerator, typename TEnumeratorKey, typename TPredicate, typename TSetAllocator = FDefaultSetAllocator>
+	using TEnumeratorIntersectBy = TEnumeratorKeySetBy<TEnumerator, TEnumeratorKey, TPredicate, true, TSetAllocator>;
+
+	template <typename TEnumeratorKey, typename TPredicate, bool IsIntersect, typename TSetAllocator = FDefaultSetAllocator>
+	struct TGeneratorKeySetBy
+	{
+	public:
+		TEnumeratorKey Key;
+		TPredicate Pred;
+
+		TGeneratorKeySetBy(TEnumeratorKey&& Key, TPredicate&& Pred) : Key(Forward<TEnumeratorKey>(Key)), Pred(Forward<TPredicate>(Pred))
+		{
+		}
+
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			return TEnumeratorKeySetBy<TEnumerator, TEnumeratorKey, TPredicate, IsIntersect, TSetAllocator>(MoveTemp(Enumerator), Forward<TEnumeratorKey>(Key), Forward<TPredicate>(Pred));
+		}
+	};
+
+	template <typename TEnumeratorKey, typename TPredicate, typename TSetAllocator = FDefaultSetAllocator>
+	using TGeneratorExceptBy = TGeneratorKeySetBy<TEnumeratorKey, TPredicate, false, TSetAllocator>;
+
+	template <typename TEnumeratorKey, typename TPredicate, typename TSetAllocator = FDefaultSetAllocator>
+	using TGeneratorIntersectBy = TGeneratorKeySetBy<TEnumeratorKey, TPredicate, true, TSetAllocator>;
+
+	template <typename TEnumerator, typename TEnumeratorSecond, typename TPredicate, typename TSetAllocator = FDefaultSetAllocator>
+	struct TEnumeratorUnionBy
+	{
+	public:
+		typedef typename TEnumerator::ElementType ElementType;
+		typedef typename Lambda<TPredicate>::ReturnType KeySelectorType;
+		TEnumerator Enumerator;
+		TEnumeratorSecond Second;
+		TPredicate Pred;
+		TSet<KeySelectorType, DefaultKeyFuncs<KeySelectorType>, TSetAllocator> Keys;
+		bool IsFirstDone = false;
+		bool MoveStart = false;
+		LINQ_STAGE_COUNTER("UnionBy")
+
+		TEnumeratorUnionBy(TEnumerator&& Enumerator, TEnumeratorSecond&& Second, TPredicate&& Pred) : Enumerator(MoveTemp(Enumerator)), Second(Forward<TEnumeratorSecond>(Second)), Pred(Forward<TPredicate>(Pred))
+		{
+		}
+
+		bool IsFirstSeen(ElementType& Element)
+		{
+			bool IsAlreadyInSet;
+			LINQ_COUNT(Pulled, 1);
+			Keys.Emplace(LINQ_CALL(Pred(Element)), &IsAlreadyInSet);
+			LINQ_COUNT(Yielded, IsAlreadyInSet ? 0 : 1);
+			return !IsAlreadyInSet;
+		}
+
+		bool MoveNext()
+		{
+			if (false == MoveStart)
+			{
+				Keys.Reserve(Enumerator.MaxNum() + Second.MaxNum());
+				MoveStart = true;
+			}
+
+			while (!IsFirstDone)
+			{
+				if (!Enumerator.MoveNext())
+				{
+					IsFirstDone = true;
+					break;
+				}
+				if (IsFirstSeen(Enumerator.Current()))
+				{
+					return true;
+				}
+			}
+
+			while (Second.MoveNext())
+			{
+				if (IsFirstSeen(Second.Current()))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		ElementType& Current()
+		{
+			return IsFirstDone ? Second.Current() : Enumerator.Current();
+		}
+
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			if (false == MoveStart)
+			{
+				Keys.Reserve(Enumerator.MaxNum() + Second.MaxNum());
+				MoveStart = true;
+			}
+
+			auto Filter = [this, &Sink](ElementType& Element)
+			{
+				return !IsFirstSeen(Element) || Sink(Element);
+			};
+			if (!IsFirstDone)
+			{
+				if (!Enumerator.ForEach(Filter))
+				{
+					return false;
+				}
+				IsFirstDone = true;
+			}
+			return Second.ForEach(Filter);
+		}
+
+		static constexpr bool IsExactNum = false;
+		static constexpr bool IsStableReference = TEnumerator::IsStableReference && TEnumeratorSecond::IsStableReference;
+
+		int MaxNum() const
+		{
+			return (IsFirstDone ? 0 : Enumerator.MaxNum()) + Second.MaxNum();
+		}
+
+		template <typename TGenerator>
+		auto operator>>(TGenerator Generator)
+		{
+			return Generator.Gen(*this);
+		}
+	};
+
+	template <typename TEnumeratorSecond, typename TPredicate, typename TSetAllocator = FDefaultSetAllocator>
+	struct TGeneratorUnionBy
+	{
+	public:
+		TEnumeratorSecond Second;
+		TPredicate Pred;
+
+		TGeneratorUnionBy(TEnumeratorSecond&& Second, TPredicate&& Pred) : Second(Forward<TEnumeratorSecond>(Second)), Pred(Forward<TPredicate>(Pred))
+		{
+		}
+
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			return TEnumeratorUnionBy<TEnumerator, TEnumeratorSecond, TPredicate, TSetAllocator>(MoveTemp(Enumerator), Forward<TEnumeratorSecond>(Second), Forward<TPredicate>(Pred));
+		}
+	};
+
+	template <typename TEnumerator, typename TEnumeratorSecond>
+	struct TEnumeratorConcat
+	{
+	public:
+		typedef typename TEnumerator::ElementType ElementType;
+		typedef std::remove_reference_t<TEnumeratorSecond> SecondType;
+		static_assert(std::is_same<ElementType, typename SecondType::ElementType>::value, "Concat needs both sequences to have the same element type");
+		TEnumerator Enumerator;
+		TEnumeratorSecond Second;
+		bool IsFirstDone = false;
+		LINQ_STAGE_COUNTER("Concat")
+
+		TEnumeratorConcat(TEnumerator&& Enumerator, TEnumeratorSecond&& Second) : Enumerator(MoveTemp(Enumerator)), Second(Forward<TEnumeratorSecond>(Second))
+		{
+		}
+
+		bool MoveNext()
+		{
+			if (false == IsFirstDone)
+			{
+				if (Enumerator.MoveNext())
+				{
+					LINQ_COUNT(Yielded, 1);
+					return true;
+				}
+				IsFirstDone = true;
+			}
+			if (Second.MoveNext())
+			{
+				LINQ_COUNT(Yielded, 1);
+				return true;
+			}
+			return false;
+		}
+
+		ElementType& Current()
+		{
+			return IsFirstDone ? Second.Current() : Enumerator.Current();
+		}
+
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			auto Counted = [this, &Sink](ElementType& Element)
+			{
+				LINQ_COUNT(Yielded, 1);
+				return Sink(Element);
+			};
+			if (false == IsFirstDone)
+			{
+				if (!Enumerator.ForEach(Counted))
+				{
+					return false;
+				}
+				IsFirstDone = true;
+			}
+			return Second.ForEach(Counted);
+		}
+
+		static constexpr bool IsExactNum = TEnumerator::IsExactNum && SecondType::IsExactNum;
+		static constexpr bool IsStableReference = TEnumerator::IsStableReference && SecondType::IsStableReference;
+		static constexpr bool IsRandomAccess = TIsRandomAccess<TEnumerator>::Value && TIsRandomAccess<SecondType>::Value;
+
+		int MaxNum() const
+		{
+			return (IsFirstDone ? 0 : Enumerator.MaxNum()) + Second.MaxNum();
+		}
+
+		ElementType& ElementAt(int Offset)
+		{
+			const int FirstNum = Enumerator.MaxNum();
+			return Offset < FirstNum ? Enumerator.ElementAt(Offset) : Second.ElementAt(Offset - FirstNum);
+		}
+
+		void Advance(int Count)
+		{
+			const int FirstCount = FMath::Min(Count, Enumerator.MaxNum());
+			Enumerator.Advance(FirstCount);
+			Second.Advance(Count - FirstCount);
+		}
+
+		template <typename TBudget>
+		bool Prepare(TBudget& Budget)
+		{
+			return Linq::Prepare(Enumerator, Budget) && Linq::Prepare(Second, Budget);
+		}
+
+		template <typename TGenerator>
+		auto operator>>(TGenerator Generator)
+		{
+			return Generator.Gen(*this);
+		}
+	};
+
+	template <typename TEnumeratorSecond>
+	struct TGeneratorConcat
+	{
+	public:
+		TEnumeratorSecond Second;
+
+		TGeneratorConcat(TEnumeratorSecond&& Second) : Second(Forward<TEnumeratorSecond>(Second))
+		{
+		}
+
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			return TEnumeratorConcat<TEnumerator, TEnumeratorSecond>(MoveTemp(Enumerator), Forward<TEnumeratorSecond>(Second));
+		}
+	};
+
+	// Pairs elements up until the shorter sequence ends; the selector builds each result by value.
+	template <typename TEnumerator, typename TEnumeratorSecond, typename TPredicate>
+	struct TEnumeratorZip
+	{
+	public:
+		typedef std::remove_reference_t<TEnumeratorSecond> SecondType;
+		typedef std::decay_t<std::invoke_result_t<TPredicate&, typename TEnumerator::ElementType&, typename SecondType::ElementType&>> ElementType;
+		TEnumerator Enumerator;
+		TEnumeratorSecond Second;
+		TPredicate Pred;
+		TOptional<ElementType> CurrentValue;
+		LINQ_STAGE_COUNTER("Zip")
+
+		TEnumeratorZip(TEnumerator&& Enumerator, TEnumeratorSecond&& Second, TPredicate&& Pred) : Enumerator(MoveTemp(Enumerator)), Second(Forward<TEnumeratorSecond>(Second)), Pred(Forward<TPredicate>(Pred))
+		{
+		}
+
+		bool MoveNext()
+		{
+			if (Enumerator.MoveNext() && Second.MoveNext())
+			{
+				LINQ_COUNT(Pulled, 1);
+				LINQ_COUNT(Yielded, 1);
+				CurrentValue.Emplace(LINQ_CALL(Pred(Enumerator.Current(), Second.Current())));
+				return true;
+			}
+			return false;
+		}
+
+		ElementType& Current()
+		{
+			return CurrentValue.GetValue();
+		}
+
+		// The first sequence is pushed and the second pulled alongside it.
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			bool IsSinkStopped = false;
+			bool IsSecondDone = false;
+			const bool IsDrained = Enumerator.ForEach([this, &Sink, &IsSinkStopped, &IsSecondDone](typename TEnumerator::ElementType& Element)
+			{
+				if (!Second.MoveNext())
+				{
+					IsSecondDone = true;
+					return false;
+				}
+				LINQ_COUNT(Pulled, 1);
+				LINQ_COUNT(Yielded, 1);
+				ElementType Value = LINQ_CALL(Pred(Element, Second.Current()));
+				IsSinkStopped = !Sink(Value);
+				return !IsSinkStopped;
+			});
+			return !IsSinkStopped && (IsDrained || IsSecondDone);
+		}
+
+		static constexpr bool IsExactNum = TEnumerator::IsExactNum && SecondType::IsExactNum;
+		static constexpr bool IsStableReference = false;
+		static constexpr bool IsRandomAccess = TIsRandomAccess<TEnumerator>::Value && TIsRandomAccess<SecondType>::Value;
+
+		int MaxNum() const
+		{
+			return FMath::Min(Enumerator.MaxNum(), Second.MaxNum());
+		}
+
+		ElementType& ElementAt(int Offset)
+		{
+			LINQ_COUNT(Pulled, 1);
+			LINQ_COUNT(Yielded, 1);
+			return CurrentValue.Emplace(LINQ_CALL(Pred(Enumerator.ElementAt(Offset), Second.ElementAt(Offset))));
+		}
+
+		void Advance(int Count)
+		{
+			Enumerator.Advance(Count);
+			Second.Advance(Count);
+		}
+
+		template <typename TBudget>
+		bool Prepare(TBudget& Budget)
+		{
+			return Linq::Prepare(Enumerator, Budget) && Linq::Prepare(Second, Budget);
+		}
+
+		template <typename TGenerator>
+		auto operator>>(TGenerator Generator)
+		{
+			return Generator.Gen(*this);
+		}
+	};
+
+	template <typename TEnumeratorSecond, typename TPredicate>
+	struct TGeneratorZip
+	{
+	public:
+		TEnumeratorSecond Second;
+		TPredicate Pred;
+
+		TGeneratorZip(TEnumeratorSecond&& Second, TPredicate&& Pred) : Second(Forward<TEnumeratorSecond>(Second)), Pred(Forward<TPredicate>(Pred))
+		{
+		}
+
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			return TEnumeratorZip<TEnumerator, TEnumeratorSecond, TPredicate>(MoveTemp(Enumerator), Forward<TEnumeratorSecond>(Second), Forward<TPredicate>(Pred));
+		}
+	};
+
+	template <typename T, typename = void>
+	struct TIsEnumerator
+	{
+		static constexpr bool Value = false;
+	};
+
+	template <typename T>
+	struct TIsEnumerator<T, std::void_t<decltype(DeclVal<T&>().MoveNext())>>
+	{
+		static constexpr bool Value = true;
+	};
+
+	template <typename T, typename = void>
+	struct TIsContiguous
+	{
+		static constexpr bool Value = false;
+	};
+
+	template <typename T>
+	struct TIsContiguous<T, std::void_t<decltype(DeclVal<T&>().GetData()), decltype(DeclVal<T&>().Num())>>
+	{
+		static constexpr bool Value = std::is_pointer<decltype(DeclVal<T&>().GetData())>::value;
+	};
+
+	// Anything From has a dedicated overload for; the variadic From must not swallow one as a single element.
+	template <typename T, typename = void>
+	struct TIsContainer
+	{
+		static constexpr bool Value = false;
+	};
+
+	template <typename T>
+	struct TIsContainer<T, std::void_t<decltype(DeclVal<T&>().begin()), decltype(DeclVal<T&>().Num())>>
+	{
+		static constexpr bool Value = true;
+	};
+
+	// What a SelectMany projection may return: an enumerator (e.g. From(Squad.Units)), a container reference,
+	// which is walked in place, or a TArray by value, which the inner enumerator takes ownership of.
+	template <typename TInner>
+	auto MakeInnerEnumerator(TInner&& Inner)
+	{
+		typedef std::remove_reference_t<TInner> InnerType;
+		if constexpr (TIsEnumerator<InnerType>::Value)
+		{
+			return InnerType(Forward<TInner>(Inner));
+		}
+		else if constexpr (false == std::is_lvalue_reference<TInner>::value)
+		{
+			return TEnumeratorArray<typename InnerType::ElementType>(MoveTemp(Inner));
+		}
+		else if constexpr (TIsContiguous<InnerType>::Value)
+		{
+			return TEnumeratorArray<std::remove_pointer_t<decltype(Inner.GetData())>>(Inner.GetData(), Inner.Num());
+		}
+		else
+		{
+			return TEnumeratorRange<decltype(Inner.begin()), true>(Inner.begin(), Inner.end(), Inner.Num());
+		}
+	}
+
+	template <typename TEnumerator, typename TPredicate>
+	struct TEnumeratorSelectMany
+	{
+	public:
+		typedef std::invoke_result_t<TPredicate&, typename TEnumerator::ElementType&> ReturnType;
+		typedef decltype(MakeInnerEnumerator(DeclVal<ReturnType>())) InnerType;
+		typedef typename InnerType::ElementType ElementType;
+		// A container returned by value lives in the inner enumerator and dies with it.
+		static constexpr bool IsOwnedInner = false == TIsEnumerator<std::remove_reference_t<ReturnType>>::Value && false == std::is_lvalue_reference<ReturnType>::value;
+		// Inner sizes are summed on the first MaxNum call when the outer elements can be reached without disturbing
+		// the cursor and the projection only hands out a reference or an enumerator, so nothing is copied to count it.
+		static constexpr bool IsSizeKnown = TIsRandomAccess<TEnumerator>::Value && TEnumerator::IsStableReference && InnerType::IsExactNum && false == IsOwnedInner;
+		TEnumerator Enumerator;
+		TPredicate Pred;
+		TOptional<InnerType> Inner;
+		// Sizes of the inners not opened yet; -1 until MaxNum first asks, so a query never sized never projects twice.
+		mutable int UnopenedNum = -1;
+		LINQ_STAGE_COUNTER("SelectMany")
+
+		TEnumeratorSelectMany(TEnumerator&& Enumerator, TPredicate&& Pred) : Enumerator(MoveTemp(Enumerator)), Pred(Forward<TPredicate>(Pred))
+		{
+		}
+
+		int SumUnopened()
+		{
+			int Sum = 0;
+			const int OuterNum = Enumerator.MaxNum();
+			for (int Offset = 0; Offset < OuterNum; ++Offset)
+			{
+				Sum += MakeInnerEnumerator(Pred(Enumerator.ElementAt(Offset))).MaxNum();
+			}
+			return Sum;
+		}
+
+		void Open(typename TEnumerator::ElementType& Element)
+		{
+			LINQ_COUNT(Pulled, 1);
+			Inner.Emplace(MakeInnerEnumerator(LINQ_CALL(Pred(Element))));
+			if (IsSizeKnown && UnopenedNum >= 0)
+			{
+				UnopenedNum -= Inner->MaxNum();
+			}
+		}
+
+		bool MoveNext()
+		{
+			while (false == Inner.IsSet() || false == Inner->MoveNext())
+			{
+				if (false == Enumerator.MoveNext())
+				{
+					return false;
+				}
+				Open(Enumerator.Current());
+			}
+			LINQ_COUNT(Yielded, 1);
+			return true;
+		}
+
+		ElementType& Current()
+		{
+			return Inner->Current();
+		}
+
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			auto Counted = [this, &Sink](ElementType& Element)
+			{
+				LINQ_COUNT(Yielded, 1);
+				return Sink(Element);
+			};
+			if (Inner.IsSet() && !Inner->ForEach(Counted))
+			{
+				return false;
+			}
+			return Enumerator.ForEach([this, &Counted](typename TEnumerator::ElementType& Element)
+			{
+				Open(Element);
+				return Inner->ForEach(Counted);
+			});
+		}
+
+		static constexpr bool IsExactNum = IsSizeKnown;
+		static constexpr bool IsStableReference = InnerType::IsStableReference && TEnumerator::IsStableReference && false == IsOwnedInner;
+
+		// Without the sum the total is unknown; the open inner alone is not a bound. Stages are never const objects,
+		// MaxNum is const only for the stages forwarding it.
+		int MaxNum() const
+		{
+			if constexpr (IsSizeKnown)
+			{
+				if (UnopenedNum < 0)
+				{
+					UnopenedNum = const_cast<TEnumeratorSelectMany*>(this)->SumUnopened();
+				}
+				return (Inner.IsSet() ? Inner->MaxNum() : 0) + UnopenedNum;
+			}
+			else
+			{
+				return 0;
+			}
+		}
+
+		template <typename TGenerator>
+		auto operator>>(TGenerator Generator)
+		{
+			return Generator.Gen(*this);
+		}
+	};
+
+	template <typename TPredicate>
+	struct TGeneratorSelectMany
+	{
+	public:
+		TPredicate Pred;
+
+		TGeneratorSelectMany(TPredicate&& Pred) : Pred(Forward<TPredicate>(Pred))
+		{
+		}
+
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			return TEnumeratorSelectMany<TEnumerator, TPredicate>(MoveTemp(Enumerator), Forward<TPredicate>(Pred));
+		}
+	};
+
+	struct FJoinChain
+	{
+	public:
+		int First;
+		int Last;
+		int Num;
+	};
+
+	// One side of a join buffered once and hashed by key; equal keys are chained through Next in source order.
+	template <typename TElementType, typename TKeyType, bool IsStableReference, typename TAllocator, typename TSetAllocator>
+	struct TJoinTable
+	{
+	public:
+		TElementBuffer<TElementType, IsStableReference, TAllocator> Elements;
+		TMap<TKeyType, FJoinChain, TSetAllocator> Chains;
+		TArray<int, TAllocator> Next;
+
+		template <typename TEnumerator, typename TKeySelector, typename TBudget>
+		bool Gather(TEnumerator& Enumerator, TKeySelector& KeySelector, TBudget& Budget)
+		{
+			if (Elements.Num() == 0)
+			{
+				const int Num = Enumerator.MaxNum();
+				Elements.Reserve(Num);
+				Chains.Reserve(Num);
+				Next.Reserve(Num);
+			}
+			return Enumerator.ForEach([this, &KeySelector, &Budget](TElementType& Element)
+			{
+				const int Index = Elements.Num();
+				TKeyType Key = KeySelector(Element);
+				if (FJoinChain* Chain = Chains.Find(Key))
+				{
+					Next[Chain->Last] = Index;
+					Chain->Last = Index;
+					Chain->Num += 1;
+				}
+				else
+				{
+					Chains.Add(MoveTemp(Key), FJoinChain{Index, Index, 1});
+				}
+				Next.Add(-1);
+				Elements.Add(Element);
+				return Budget.Consume();
+			});
+		}
+
+		const FJoinChain* Find(const TKeyType& Key) const
+		{
+			return Chains.Find(Key);
+		}
+
+		SIZE_T GetAllocatedSize() const
+		{
+			return Elements.Items.GetAllocatedSize() + Chains.GetAllocatedSize() + Next.GetAllocatedSize();
+		}
+	};
+
+	// The element a join is streaming. A pushed element that stops the sink mid-chain is copied when the
+	// upstream reference would not outlive the ForEach call.
+	template <typename TElementType, bool IsStableReference>
+	struct TJoinHeld
+	{
+	public:
+		TElementType* Element = nullptr;
+		TOptional<std::remove_const_t<TElementType>> Copy;
+
+		void Keep(TElementType& Value)
+		{
+			if constexpr (IsStableReference)
+			{
+				Element = &Value;
+			}
+			else
+			{
+				Element = &Copy.Emplace(Value);
+			}
+		}
+	};
+
+	// Hashes the inner side and streams the outer, so results follow the outer order. With IsSmallerSideHashed the
+	// outer side is hashed instead when both sizes are exact and it is the smaller one; results then follow the
+	// inner order, which can change from run to run as the sizes change.
+	template <typename TEnumerator, typename TEnumeratorInner, typename TOuterKey, typename TInnerKey, typename TResult, typename TAllocator = FDefaultAllocator, typename TSetAllocator = FDefaultSetAllocator>
+	struct TEnumeratorJoin
+	{
+	public:
+		typedef std::remove_reference_t<TEnumeratorInner> InnerEnumeratorType;
+		typedef typename TEnumerator::ElementType OuterType;
+		typedef typename InnerEnumeratorType::ElementType InnerType;
+		typedef std::decay_t<std::invoke_result_t<TOuterKey&, OuterType&>> KeyType;
+		typedef std::decay_t<std::invoke_result_t<TResult&, OuterType&, InnerType&>> ElementType;
+		TEnumerator Enumerator;
+		TEnumeratorInner Inner;
+		TOuterKey OuterKey;
+		TInnerKey InnerKey;
+		TResult ResultSelector;
+		TJoinTable<OuterType, KeyType, TEnumerator::IsStableReference, TAllocator, TSetAllocator> OuterTable;
+		TJoinTable<InnerType, KeyType, InnerEnumeratorType::IsStableReference, TAllocator, TSetAllocator> InnerTable;
+		TJoinHeld<OuterType, TEnumerator::IsStableReference> HeldOuter;
+		TJoinHeld<InnerType, InnerEnumeratorType::IsStableReference> HeldInner;
+		TOptional<ElementType> CurrentValue;
+		int Match = -1;
+		bool IsSmallerSideHashed;
+		bool IsOuterHashed = false;
+		bool IsModeChosen = false;
+		bool IsGathered = false;
+		LINQ_STAGE_COUNTER("Join")
+
+		TEnumeratorJoin(TEnumerator&& Enumerator, TEnumeratorInner&& Inner, TOuterKey&& OuterKey, TInnerKey&& InnerKey, TResult&& ResultSelector, bool IsSmallerSideHashed)
+			: Enumerator(MoveTemp(Enumerator)), Inner(Forward<TEnumeratorInner>(Inner)), OuterKey(Forward<TOuterKey>(OuterKey)), InnerKey(Forward<TInnerKey>(InnerKey)), ResultSelector(Forward<TResult>(ResultSelector)), IsSmallerSideHashed(IsSmallerSideHashed)
+		{
+		}
+
+		template <typename TBudget>
+		bool Prepare(TBudget& Budget)
+		{
+			if (false == IsModeChosen)
+			{
+				IsOuterHashed = IsSmallerSideHashed && TEnumerator::IsExactNum && InnerEnumeratorType::IsExactNum && Enumerator.MaxNum() < Inner.MaxNum();
+				IsModeChosen = true;
+			}
+			if (false == IsGathered)
+			{
+				LINQ_TRACE_SCOPE(Linq_Join);
+				LINQ_CYCLE_SCOPE();
+				const bool IsDrained = IsOuterHashed
+					? Linq::Prepare(Enumerator, Budget) && OuterTable.Gather(Enumerator, OuterKey, Budget)
+					: Linq::Prepare(Inner, Budget) && InnerTable.Gather(Inner, InnerKey, Budget);
+				if (false == IsDrained)
+				{
+					return false;
+				}
+				LINQ_COUNT(ScratchBytes, IsOuterHashed ? OuterTable.GetAllocatedSize() : InnerTable.GetAllocatedSize());
+				IsGathered = true;
+			}
+			return IsOuterHashed ? Linq::Prepare(Inner, Budget) : Linq::Prepare(Enumerator, Budget);
+		}
+
+		void Start()
+		{
+			FUnlimitedBudget Budget;
+			while (false == Prepare(Budget))
+			{
+			}
+		}
+
+		template <bool IsOuterStreamed>
+		auto& Streamed()
+		{
+			if constexpr (IsOuterStreamed)
+			{
+				return Enumerator;
+			}
+			else
+			{
+				return Inner;
+			}
+		}
+
+		template <bool IsOuterStreamed>
+		auto& Hashed()
+		{
+			if constexpr (IsOuterStreamed)
+			{
+				return InnerTable;
+			}
+			else
+			{
+				return OuterTable;
+			}
+		}
+
+		template <bool IsOuterStreamed>
+		auto& Held()
+		{
+			if constexpr (IsOuterStreamed)
+			{
+				return HeldOuter;
+			}
+			else
+			{
+				return HeldInner;
+			}
+		}
+
+		template <bool IsOuterStreamed, typename TStreamed>
+		int FindFirst(TStreamed& Element)
+		{
+			LINQ_COUNT(Pulled, 1);
+			const FJoinChain* Chain;
+			if constexpr (IsOuterStreamed)
+			{
+				Chain = InnerTable.Find(KeyType(OuterKey(Element)));
+			}
+			else
+			{
+				Chain = OuterTable.Find(KeyType(InnerKey(Element)));
+			}
+			return Chain ? Chain->First : -1;
+		}
+
+		template <bool IsOuterStreamed, typename TStreamed>
+		ElementType Emit(TStreamed& Element, int Index)
+		{
+			LINQ_COUNT(Yielded, 1);
+			if constexpr (IsOuterStreamed)
+			{
+				return LINQ_CALL(ResultSelector(Element, InnerTable.Elements[Index]));
+			}
+			else
+			{
+				return LINQ_CALL(ResultSelector(OuterTable.Elements[Index], Element));
+			}
+		}
+
+		template <bool IsOuterStreamed>
+		bool MoveNextStreamed()
+		{
+			auto& Stream = Streamed<IsOuterStreamed>();
+			auto& Holder = Held<IsOuterStreamed>();
+			while (Match == -1)
+			{
+				if (false == Stream.MoveNext())
+				{
+					return false;
+				}
+				Holder.Element = &Stream.Current();
+				Match = FindFirst<IsOuterStreamed>(*Holder.Element);
+			}
+			CurrentValue.Emplace(Emit<IsOuterStreamed>(*Holder.Element, Match));
+			Match = Hashed<IsOuterStreamed>().Next[Match];
+			return true;
+		}
+
+		// Emits the chain from Match for Element; on a stop, Match is left on the next entry of the chain.
+		template <bool IsOuterStreamed, typename TStreamed, typename TSink>
+		bool EmitChain(TStreamed& Element, TSink& Sink)
+		{
+			const TArray<int>& Next = Hashed<IsOuterStreamed>().Next;
+			while (Match != -1)
+			{
+				ElementType Value = Emit<IsOuterStreamed>(Element, Match);
+				Match = Next[Match];
+				if (!Sink(Value))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		template <bool IsOuterStreamed, typename TSink>
+		bool ForEachStreamed(TSink& Sink)
+		{
+			auto& Holder = Held<IsOuterStreamed>();
+			if (Match != -1 && !EmitChain<IsOuterStreamed>(*Holder.Element, Sink))
+			{
+				return false;
+			}
+			typedef std::remove_reference_t<decltype(*Holder.Element)> StreamedType;
+			return Streamed<IsOuterStreamed>().ForEach([this, &Sink, &Holder](StreamedType& Element)
+			{
+				Match = FindFirst<IsOuterStreamed>(Element);
+				if (EmitChain<IsOuterStreamed>(Element, Sink))
+				{
+					return true;
+				}
+				if (Match != -1)
+				{
+					Holder.Keep(Element);
+				}
+				return false;
+			});
+		}
+
+		bool MoveNext()
+		{
+			if (false == IsGathered)
+			{
+				Start();
+			}
+			return IsOuterHashed ? MoveNextStreamed<false>() : MoveNextStreamed<true>();
+		}
+
+		ElementType& Current()
+		{
+			return CurrentValue.GetValue();
+		}
+
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			if (false == IsGathered)
+			{
+				Start();
+			}
+			return IsOuterHashed ? ForEachStreamed<false>(Sink) : ForEachStreamed<true>(Sink);
+		}
+
+		static constexpr bool IsExactNum = false;
+		static constexpr bool IsStableReference = false;
+
+		// A key shared by several elements on both sides multiplies matches, so neither input size bounds the output.
+		int MaxNum() const
+		{
+			return 0;
+		}
+
+		template <typename TGenerator>
+		auto operator>>(TGenerator Generator)
+		{
+			return Generator.Gen(*this);
+		}
+	};
+
+	template <typename TEnumeratorInner, typename TOuterKey, typename TInnerKey, typename TResult, typename TAllocator = FDefaultAllocator, typename TSetAllocator = FDefaultSetAllocator>
+	struct TGeneratorJoin
+	{
+	public:
+		TEnumeratorInner Inner;
+		TOuterKey OuterKey;
+		TInnerKey InnerKey;
+		TResult ResultSelector;
+		bool IsSmallerSideHashed;
+
+		TGeneratorJoin(TEnumeratorInner&& Inner, TOuterKey&& OuterKey, TInnerKey&& InnerKey, TResult&& ResultSelector, bool IsSmallerSideHashed)
+			: Inner(Forward<TEnumeratorInner>(Inner)), OuterKey(Forward<TOuterKey>(OuterKey)), InnerKey(Forward<TInnerKey>(InnerKey)), ResultSelector(Forward<TResult>(ResultSelector)), IsSmallerSideHashed(IsSmallerSideHashed)
+		{
+		}
+
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			return TEnumeratorJoin<TEnumerator, TEnumeratorInner, TOuterKey, TInnerKey, TResult, TAllocator, TSetAllocator>(MoveTemp(Enumerator), Forward<TEnumeratorInner>(Inner), Forward<TOuterKey>(OuterKey), Forward<TInnerKey>(InnerKey), Forward<TResult>(ResultSelector), IsSmallerSideHashed);
+		}
+	};
+
+	// The inner elements matching one outer element, walked along the join table's chain. It reads the GroupJoin
+	// stage's table, so it only lives for the selector call: it cannot be copied out, and the selector may not return it
+	// or a stage built on it. Collect the matches with ToArray() to keep them.
+	template <typename TJoinTable, typename TElementType>
+	struct TEnumeratorJoinGroup
+	{
+	public:
+		typedef TElementType ElementType;
+		TJoinTable* Table;
+		int Index = -1;
+		int NextIndex;
+		int Remaining;
+
+		TEnumeratorJoinGroup(TJoinTable* Table, const FJoinChain* Chain) : Table(Table), NextIndex(Chain ? Chain->First : -1), Remaining(Chain ? Chain->Num : 0)
+		{
+		}
+
+		// Moves stay so stages can be chained onto the group inside the selector.
+		TEnumeratorJoinGroup(const TEnumeratorJoinGroup&) = delete;
+		TEnumeratorJoinGroup(TEnumeratorJoinGroup&&) = default;
+		TEnumeratorJoinGroup& operator=(const TEnumeratorJoinGroup&) = delete;
+
+		bool MoveNext()
+		{
+			if (NextIndex == -1)
+			{
+				return false;
+			}
+			Index = NextIndex;
+			NextIndex = Table->Next[Index];
+			Remaining -= 1;
+			return true;
+		}
+
+		ElementType& Current()
+		{
+			return Table->Elements[Index];
+		}
+
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			while (MoveNext())
+			{
+				if (!Sink(Current()))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		static constexpr bool IsExactNum = true;
+		static constexpr bool IsStableReference = true;
+
+		int MaxNum() const
+		{
+			return Remaining;
+		}
+
+		template <typename TGenerator>
+		auto operator>>(TGenerator Generator)
+		{
+			return Generator.Gen(*this);
+		}
+	};
+
+	// Every outer element is yielded once, with an enumerator over its (possibly empty) inner matches.
+	template <typename TEnumerator, typename TEnumeratorInner, typename TOuterKey, typename TInnerKey, typename TResult, typename TAllocator = FDefaultAllocator, typename TSetAllocator = FDefaultSetAllocator>
+	struct TEnumeratorGroupJoin
+	{
+	public:
+		typedef std::remove_reference_t<TEnumeratorInner> InnerEnumeratorType;
+		typedef typename TEnumerator::ElementType OuterType;
+		typedef typename InnerEnumeratorType::ElementType InnerType;
+		typedef std::decay_t<std::invoke_result_t<TOuterKey&, OuterType&>> KeyType;
+		typedef TJoinTable<InnerType, KeyType, InnerEnumeratorType::IsStableReference, TAllocator, TSetAllocator> TableType;
+		typedef TEnumeratorJoinGroup<TableType, InnerType> GroupType;
+		typedef std::decay_t<std::invoke_result_t<TResult&, OuterType&, GroupType&>> ElementType;
+		static_assert(false == TIsEnumerator<ElementType>::Value, "GroupJoin's selector cannot return the group or a stage over it, collect it with ToArray()");
+		TEnumerator Enumerator;
+		TEnumeratorInner Inner;
+		TOuterKey OuterKey;
+		TInnerKey InnerKey;
+		TResult ResultSelector;
+		TableType InnerTable;
+		TOptional<ElementType> CurrentValue;
+		bool IsGathered = false;
+		LINQ_STAGE_COUNTER("GroupJoin")
+
+		TEnumeratorGroupJoin(TEnumerator&& Enumerator, TEnumeratorInner&& Inner, TOuterKey&& OuterKey, TInnerKey&& InnerKey, TResult&& ResultSelector)
+			: Enumerator(MoveTemp(Enumerator)), Inner(Forward<TEnumeratorInner>(Inner)), OuterKey(Forward<TOuterKey>(OuterKey)), InnerKey(Forward<TInnerKey>(InnerKey)), ResultSelector(Forward<TResult>(ResultSelector))
+		{
+		}
+
+		template <typename TBudget>
+		bool Prepare(TBudget& Budget)
+		{
+			if (false == IsGathered)
+			{
+				LINQ_TRACE_SCOPE(Linq_GroupJoin);
+				LINQ_CYCLE_SCOPE();
+				if (false == (Linq::Prepare(Inner, Budget) && InnerTable.Gather(Inner, InnerKey, Budget)))
+				{
+					return false;
+				}
+				LINQ_COUNT(ScratchBytes, InnerTable.GetAllocatedSize());
+				IsGathered = true;
+			}
+			return Linq::Prepare(Enumerator, Budget);
+		}
+
+		void Start()
+		{
+			FUnlimitedBudget Budget;
+			while (false == Prepare(Budget))
+			{
+			}
+		}
+
+		ElementType Emit(OuterType& Element)
+		{
+			LINQ_COUNT(Pulled, 1);
+			LINQ_COUNT(Yielded, 1);
+			GroupType Group(&InnerTable, InnerTable.Find(KeyType(OuterKey(Element))));
+			return LINQ_CALL(ResultSelector(Element, Group));
+		}
+
+		bool MoveNext()
+		{
+			if (false == IsGathered)
+			{
+				Start();
+			}
+			if (Enumerator.MoveNext())
+			{
+				CurrentValue.Emplace(Emit(Enumerator.Current()));
+				return true;
+			}
+			return false;
+		}
+
+		ElementType& Current()
+		{
+			return CurrentValue.GetValue();
+		}
+
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			if (false == IsGathered)
+			{
+				Start();
+			}
+			return Enumerator.ForEach([this, &Sink](OuterType& Element)
+			{
+				ElementType Value = Emit(Element);
+				return Sink(Value);
+			});
+		}
+
+		static constexpr bool IsExactNum = TEnumerator::IsExactNum;
+		static constexpr bool IsStableReference = false;
+
+		int MaxNum() const
+		{
+			return Enumerator.MaxNum();
+		}
+
+		template <typename TGenerator>
+		auto operator>>(TGenerator Generator)
+		{
+			return Generator.Gen(*this);
+		}
+	};
+
+	template <typename TEnumeratorInner, typename TOuterKey, typename TInnerKey, typename TResult, typename TAllocator = FDefaultAllocator, typename TSetAllocator = FDefaultSetAllocator>
+	struct TGeneratorGroupJoin
+	{
+	public:
+		TEnumeratorInner Inner;
+		TOuterKey OuterKey;
+		TInnerKey InnerKey;
+		TResult ResultSelector;
+
+		TGeneratorGroupJoin(TEnumeratorInner&& Inner, TOuterKey&& OuterKey, TInnerKey&& InnerKey, TResult&& ResultSelector)
+			: Inner(Forward<TEnumeratorInner>(Inner)), OuterKey(Forward<TOuterKey>(OuterKey)), InnerKey(Forward<TInnerKey>(InnerKey)), ResultSelector(Forward<TResult>(ResultSelector))
+		{
+		}
+
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			return TEnumeratorGroupJoin<TEnumerator, TEnumeratorInner, TOuterKey, TInnerKey, TResult, TAllocator, TSetAllocator>(MoveTemp(Enumerator), Forward<TEnumeratorInner>(Inner), Forward<TOuterKey>(OuterKey), Forward<TInnerKey>(InnerKey), Forward<TResult>(ResultSelector));
+		}
+	};
+
+	template <typename TElementType>
+	struct TParallelStageArray
+	{
+	public:
+		typedef TElementType SourceType;
+
+		auto Make(SourceType* Data, int Size)
+		{
+			return TEnumeratorArray<SourceType>(Data, Size);
+		}
+	};
+
+	template <typename TStage, typename TPredicate>
+	struct TParallelStageWhere
+	{
+	public:
+		typedef typename TStage::SourceType SourceType;
+		TStage Stage;
+		TPredicate Pred;
+
+		TParallelStageWhere(TStage&& Stage, TPredicate&& Pred) : Stage(MoveTemp(Stage)), Pred(Forward<TPredicate>(Pred))
+		{
+		}
+
+		// Every chunk binds the same Pred by reference, nothing is moved out of the stage.
+		auto Make(SourceType* Data, int Size)
+		{
+			auto Enumerator = Stage.Make(Data, Size);
+			return TEnumeratorWhere<decltype(Enumerator), TPredicate&>(MoveTemp(Enumerator), Pred);
+		}
+	};
+
+	template <typename TStage, typename TPredicate>
+	struct TParallelStageSelect
+	{
+	public:
+		typedef typename TStage::SourceType SourceType;
+		TStage Stage;
+		TPredicate Pred;
+
+		TParallelStageSelect(TStage&& Stage, TPredicate&& Pred) : Stage(MoveTemp(Stage)), Pred(Forward<TPredicate>(Pred))
+		{
+		}
+
+		auto Make(SourceType* Data, int Size)
+		{
+			auto Enumerator = Stage.Make(Data, Size);
+			return TEnumeratorSelect<decltype(Enumerator), TPredicate&>(MoveTemp(Enumerator), Pred);
+		}
+	};
+
+	template <typename TStage>
+	struct TEnumeratorParallel
+	{
+	public:
+		typedef typename TStage::SourceType SourceType;
+		typedef decltype(DeclVal<TStage&>().Make(nullptr, 0)) SequentialType;
+		typedef typename SequentialType::ElementType ElementType;
+		TStage Stage;
+		TArray<std::remove_const_t<SourceType>> Container;
+		SourceType* Data = nullptr;
+		int Size = 0;
+		int ChunkSize = 0;
+		TOptional<SequentialType> Sequential;
+		LINQ_STAGE_COUNTER("AsParallel")
+
+		TEnumeratorParallel(TStage&& Stage, TArray<std::remove_const_t<SourceType>>&& Container, SourceType* Data, int Size, int ChunkSize)
+			: Stage(MoveTemp(Stage)), Container(MoveTemp(Container)), Data(Data), Size(Size), ChunkSize(FMath::Max(ChunkSize, 1))
+		{
+		}
+
+		bool MoveNext()
+		{
+			if (!Sequential.IsSet())
+			{
+				Sequential.Emplace(Stage.Make(Data, Size));
+			}
+			return Sequential->MoveNext();
+		}
+
+		ElementType& Current()
+		{
+			return Sequential->Current();
+		}
+
+		template <typename TSink>
+		bool ForEach(TSink&& Sink)
+		{
+			if (!Sequential.IsSet())
+			{
+				Sequential.Emplace(Stage.Make(Data, Size));
+			}
+			return Sequential->ForEach(Sink);
+		}
+
+		static constexpr bool IsExactNum = SequentialType::IsExactNum;
+		static constexpr bool IsStableReference = SequentialType::IsStableReference;
+
+		int MaxNum() const
+		{
+			return Sequential.IsSet() ? Sequential->MaxNum() : Size;
+		}
+
+		template <typename TPredicate>
+		auto operator>>(TGeneratorWhere<TPredicate> Generator)
+		{
+			typedef TParallelStageWhere<TStage, TPredicate> FStage;
+			return TEnumeratorParallel<FStage>(FStage(MoveTemp(Stage), Forward<TPredicate>(Generator.Pred)), MoveTemp(Container), Data, Size, ChunkSize);
+		}
+
+		template <typename TPredicate>
+		auto operator>>(TGeneratorSelect<TPredicate> Generator)
+		{
+			typedef TParallelStageSelect<TStage, TPredicate> FStage;
+			return TEnumeratorParallel<FStage>(FStage(MoveTemp(Stage), Forward<TPredicate>(Generator.Pred)), MoveTemp(Container), Data, Size, ChunkSize);
+		}
+
+		template <typename TAllocator>
+		auto operator>>(TGeneratorToArray<TAllocator> Generator)
+		{
+			LINQ_TRACE_SCOPE(Linq_AsParallel);
+			LINQ_CYCLE_SCOPE();
+			LINQ_COUNT(Pulled, Size);
+			typedef std::remove_const_t<ElementType> ValueType;
+			TArray<ValueType, TAllocator> Array;
+			const int NumChunks = FMath::DivideAndRoundUp(Size, ChunkSize);
+			if constexpr (IsExactNum)
+			{
+				Array.AddUninitialized(Size);
+				ValueType* Dest = Array.GetData();
+				ParallelFor(NumChunks, [this, Dest](int32 ChunkIndex)
+				{
+					const int Begin = ChunkIndex * ChunkSize;
+					auto Enumerator = Stage.Make(Data + Begin, FMath::Min(ChunkSize, Size - Begin));
+					for (int Index = Begin; Enumerator.MoveNext(); ++Index)
+					{
+						new(Dest + Index) ValueType(Enumerator.Current());
+					}
+				}, NumChunks == 1);
+			}
+			else
+			{
+				TArray<TArray<ValueType>> Chunks;
+				Chunks.SetNum(NumChunks);
+				ParallelFor(NumChunks, [this, &Chunks](int32 ChunkIndex)
+				{
+					const int Begin = ChunkIndex * ChunkSize;
+					Chunks[ChunkIndex] = Stage.Make(Data + Begin, FMath::Min(ChunkSize, Size - Begin)) >> TGeneratorToArray<>();
+				}, NumChunks == 1);
+
+				int Num = 0;
+				for (const TArray<ValueType>& Chunk : Chunks)
+				{
+					Num += Chunk.Num();
+				}
+				Array.Reserve(Num);
+				for (TArray<ValueType>& Chunk : Chunks)
+				{
+					Array.Append(MoveTemp(Chunk));
+				}
+			}
+			LINQ_COUNT(Yielded, Array.Num());
+			return Array;
+		}
+
+		template <typename TGenerator>
+		auto operator>>(TGenerator Generator)
+		{
+			return Generator.Gen(*this);
+		}
+	};
+
+	struct TGeneratorAsParallel
+	{
+	public:
+		int ChunkSize;
+
+		TGeneratorAsParallel(int ChunkSize) : ChunkSize(ChunkSize)
+		{
+		}
+
+		template <typename TElementType>
+		auto Gen(TEnumeratorArray<TElementType>& Enumerator)
+		{
+			return TEnumeratorParallel<TParallelStageArray<TElementType>>(TParallelStageArray<TElementType>(), MoveTemp(Enumerator.Container), Enumerator.Data + Enumerator.Index + 1, Enumerator.MaxNum(), ChunkSize);
+		}
+	};
+
+	struct IBudgetedRun
+	{
+	public:
+		virtual ~IBudgetedRun()
+		{
+		}
+
+		// Does at most one budget of work; true once the query has finished and its callback has run.
+		virtual bool Tick() = 0;
+	};
+
+	// Drives a pipeline across frames: buffering stages gather and sort within the budget first, then elements are
+	// collected the same way. Streaming stages are charged per element they yield and a Where per element it rejects.
+	template <typename TEnumerator, typename TCallback>
+	struct TBudgetedRun : public IBudgetedRun
+	{
+	public:
+		typedef typename TEnumerator::ElementType ElementType;
+		TEnumerator Enumerator;
+		FBudget Budget;
+		TCallback OnComplete;
+		TArray<std::remove_const_t<ElementType>> Result;
+		bool IsPrepared = false;
+		bool IsDone = false;
+
+		TBudgetedRun(TEnumerator&& Enumerator, const FBudget& Budget, TCallback&& OnComplete) : Enumerator(MoveTemp(Enumerator)), Budget(Budget), OnComplete(MoveTemp(OnComplete))
+		{
+		}
+
+		virtual bool Tick() override
+		{
+			if (IsDone)
+			{
+				return true;
+			}
+			FBudgetClock Clock(Budget);
+			SetBudgetClock(Enumerator, &Clock);
+			IsDone = Run(Clock);
+			SetBudgetClock(Enumerator, nullptr);
+			if (IsDone)
+			{
+				OnComplete(MoveTemp(Result));
+			}
+			return IsDone;
+		}
+
+		bool Run(FBudgetClock& Clock)
+		{
+			if (false == IsPrepared)
+			{
+				IsPrepared = Linq::Prepare(Enumerator, Clock);
+				if (false == IsPrepared || Clock.IsExhausted)
+				{
+					return false;
+				}
+				if constexpr (TEnumerator::IsExactNum)
+				{
+					Result.Reserve(Enumerator.MaxNum());
+				}
+			}
+			return Enumerator.ForEach([this, &Clock](ElementType& Element)
+			{
+				if constexpr (TEnumerator::IsStableReference)
+				{
+					Result.Emplace(Element);
+				}
+				else
+				{
+					Result.Emplace(MoveTemp(Element));
+				}
+				return Clock.Consume();
+			});
+		}
+	};
+}
+
+template <typename T>
+auto From(TArray<T>& Array)
+{
+	return Linq::TEnumeratorArray<T>(Array.GetData(), Array.Num());
+}
+
+template <typename T>
+auto From(TArray<T>&& Array)
+{
+	return Linq::TEnumeratorArray<T>(MoveTemp(Array));
+}
+
+template <typename T>
+auto From(const TArray<T>& Array)
+{
+	return Linq::TEnumeratorArray<const T>(Array.GetData(), Array.Num());
+}
+
+template <typename T>
+auto From(TArrayView<T> View)
+{
+	return Linq::TEnumeratorArray<T>(View.GetData(), View.Num());
+}
+
+template <typename T, typename... TRest>
+auto From(TSet<T, TRest...>& Set)
+{
+	return Linq::TEnumeratorRange<decltype(Set.begin()), true>(Set.begin(), Set.end(), Set.Num());
+}
+
+template <typename T, typename... TRest>
+auto From(const TSet<T, TRest...>& Set)
+{
+	return Linq::TEnumeratorRange<decltype(Set.begin()), true>(Set.begin(), Set.end(), Set.Num());
+}
+
+// Hash and sparse containers are walked in place, so a temporary one would dangle.
+template <typename T, typename... TRest>
+auto From(TSet<T, TRest...>&& Set) = delete;
+
+template <typename K, typename V, typename... TRest>
+auto From(TMap<K, V, TRest...>& Map)
+{
+	return Linq::TEnumeratorRange<decltype(Map.begin()), true>(Map.begin(), Map.end(), Map.Num());
+}
+
+template <typename K, typename V, typename... TRest>
+auto From(const TMap<K, V, TRest...>& Map)
+{
+	return Linq::TEnumeratorRange<decltype(Map.begin()), true>(Map.begin(), Map.end(), Map.Num());
+}
+
+template <typename K, typename V, typename... TRest>
+auto From(TMap<K, V, TRest...>&& Map) = delete;
+
+template <typename TMapType>
+auto FromKeys(TMapType& Map)
+{
+	return From(Map) >> Select([](auto& Pair) -> auto& { return Pair.Key; });
+}
+
+template <typename TMapType>
+auto FromValues(TMapType& Map)
+{
+	return From(Map) >> Select([](auto& Pair) -> auto& { return Pair.Value; });
+}
+
+template <typename T, typename... TRest>
+auto From(TSparseArray<T, TRest...>& Array)
+{
+	return Linq::TEnumeratorRange<decltype(Array.begin()), true>(Array.begin(), Array.end(), Array.Num());
+}
+
+template <typename T, typename... TRest>
+auto From(const TSparseArray<T, TRest...>& Array)
+{
+	return Linq::TEnumeratorRange<decltype(Array.begin()), true>(Array.begin(), Array.end(), Array.Num());
+}
+
+template <typename T, typename... TRest>
+auto From(TSparseArray<T, TRest...>&& Array) = delete;
+
+// Contiguous pointer ranges stay random-access; any other iterator pair is walked in place.
+template <typename TIterator>
+auto FromRange(TIterator Begin, TIterator End)
+{
+	if constexpr (std::is_pointer<TIterator>::value)
+	{
+		return Linq::TEnumeratorArray<std::remove_pointer_t<TIterator>>(Begin, static_cast<int>(End - Begin));
+	}
+	else
+	{
+		return Linq::TEnumeratorRange<TIterator, false>(Begin, End, 0);
+	}
+}
+
+template <typename TRange>
+auto FromRange(TRange& Range)
+{
+	return FromRange(Range.begin(), Range.end());
+}
+
+// Parallel TArray/TArrayView columns of equal length as one row set; read a field with Row.Get<I>().
+template <typename TColumn, typename... TColumns>
+auto FromColumns(TColumn&& First, TColumns&&... Rest)
+{
+	const int Size = First.Num();
+	check(((Rest.Num() == Size) && ...));
+	return Linq::TEnumeratorColumns<std::remove_pointer_t<decltype(First.GetData())>, std::remove_pointer_t<decltype(Rest.GetData())>...>(Size, First.GetData(), Rest.GetData()...);
+}
+
+template <int ColumnIndex>
+auto Column()
+{
+	return Linq::TGeneratorColumn<ColumnIndex>();
+}
+
+// A pipeline defined once over a placeholder source and run many times: Query.Rebind(Array) >> ToArray().
+template <typename T>
+auto Query()
+{
+	return Linq::TEnumeratorArray<T>(nullptr, 0);
+}
+
+// Builds TIterator from Args on first pull, e.g. FromIterator<TObjectIterator<UTexture2D>>(RF_ClassDefaultObject).
+template <typename TIterator, typename... TArgs>
+auto FromIterator(TArgs... Args)
+{
+	return Linq::TEnumeratorIterator<TIterator, TArgs...>(MoveTemp(Args)...);
+}
+
+template <typename... T, typename = std::enable_if_t<sizeof...(T) != 1 || false == (Linq::TIsContainer<std::remove_reference_t<T>>::Value && ...)>>
+auto From(T&&... Args)
+{
+	TArray<std::common_type_t<T...>> Array;
+	(Array.Emplace(MoveTemp(Args)), ...);
+	return From(MoveTemp(Array));
+}
+
+template <typename TPredicate>
+auto Where(TPredicate&& Pred)
+{
+	return Linq::TGeneratorWhere<TPredicate>(Forward<TPredicate>(Pred));
+}
 
 template <typename TPredicate>
+auto Select(TPredicate&& Pred)
+{
+	return Linq::TGeneratorSelect<TPredicate>(Forward<TPredicate>(Pred));
+}
+
+template <typename TAllocator = FDefaultAllocator>
+auto ToArray()
+{
+	return Linq::TGeneratorToArray<TAllocator>();
+}
+
+template <typename TSetAllocator = FDefaultSetAllocator, typename TKeySelector, typename TValueSelector>
+auto ToMap(TKeySelector&& KeySelector, TValueSelector&& ValueSelector)
+{
+	return Linq::TGeneratorToMap<TKeySelector, TValueSelector, TSetAllocator>(Forward<TKeySelector>(KeySelector), Forward<TValueSelector>(ValueSelector));
+}
+
+template <typename TSetAllocator = FDefaultSetAllocator>
+auto ToSet()
+{
+	return Linq::TGeneratorToSet<TSetAllocator>();
+}
+
+template <typename TAction>
+auto ForEach(TAction&& Action)
+{
+	return Linq::TGeneratorForEach<TAction>(Forward<TAction>(Action));
+}
+
+template <typename TAllocator = FDefaultAllocator, typename TPredicate>
+auto OrderBy(TPredicate&& Pred)
+{
+	return Linq::TGeneratorOrderBy<TPredicate, TAllocator>(Forward<TPredicate>(Pred));
+}
+
+template <typename TAllocator = FDefaultAllocator, typename TPredicate>
+auto TopBy(int Count, TPredicate&& Pred)
+{
+	return Linq::TGeneratorTopBy<TPredicate, TAllocator>(Count, Forward<TPredicate>(Pred));
+}
+
+template <typename TAllocator = FDefaultAllocator, typename TPredicate>
 auto ThenBy(TPredicate&& Pred)
 {
-	return Linq::TGeneratorThenBy<TPredicate>(MoveTemp(Pred));
+	return Linq::TGeneratorThenBy<TPredicate, TAllocator>(Forward<TPredicate>(Pred));
+}
+
+template <typename TAllocator = FDefaultAllocator>
+auto Reverse()
+{
+	return Linq::TGeneratorReverse<TAllocator>();
+}
+
+inline auto Any()
+{
+	return Linq::TGeneratorAny<>();
+}
+
+template <typename TPredicate>
+auto Any(TPredicate&& Pred)
+{
+	return Linq::TGeneratorAny<TPredicate>(Forward<TPredicate>(Pred));
+}
+
+template <typename TPredicate>
+auto All(TPredicate&& Pred)
+{
+	return Linq::TGeneratorAll<TPredicate>(Forward<TPredicate>(Pred));
+}
+
+template <typename TValue>
+auto Contains(TValue&& Value)
+{
+	return Linq::TGeneratorContains<TValue>(Forward<TValue>(Value));
+}
+
+inline auto First()
+{
+	return Linq::TGeneratorFirst();
+}
+
+inline auto Count()
+{
+	return Linq::TGeneratorCount();
+}
+
+inline auto Sum()
+{
+	return Linq::TGeneratorSum();
+}
+
+inline auto Average()
+{
+	return Linq::TGeneratorAverage();
+}
+
+inline auto Min()
+{
+	return Linq::TGeneratorMinMax<false>();
+}
+
+inline auto Max()
+{
+	return Linq::TGeneratorMinMax<true>();
+}
+
+inline auto ElementAt(int Index)
+{
+	return Linq::TGeneratorElementAt(Index);
+}
+
+inline auto Last()
+{
+	return Linq::TGeneratorLast();
+}
+
+inline auto Take(int Count)
+{
+	return Linq::TGeneratorTake(Count);
+}
+
+inline auto Skip(int Count)
+{
+	return Linq::TGeneratorSkip(Count);
 }
 
-inline auto Reverse()
+template <typename TPredicate>
+auto TakeWhile(TPredicate&& Pred)
 {
-	return Linq::TGeneratorReverse();
+	return Linq::TGeneratorTakeWhile<TPredicate>(Forward<TPredicate>(Pred));
 }
 
 template <typename TPredicate>
-auto DistinctBy(TPredicate&& Pred)
+auto SkipWhile(TPredicate&& Pred)
+{
+	return Linq::TGeneratorSkipWhile<TPredicate>(Forward<TPredicate>(Pred));
+}
+
+template <typename TSetAllocator = FDefaultSetAllocator, typename TPredicate>
+auto DistinctBy(TPredicate&& Pred, int Capacity = 0)
+{
+	return Linq::TGeneratorDistinctBy<TPredicate, TSetAllocator>(Forward<TPredicate>(Pred), Capacity);
+}
+
+template <typename TAllocator = FDefaultAllocator, typename TSetAllocator = FDefaultSetAllocator, typename TPredicate>
+auto GroupBy(TPredicate&& Pred)
 {
-	return Linq::TGeneratorDistinctBy<TPredicate>(MoveTemp(Pred));
+	return Linq::TGeneratorGroupBy<TPredicate, TAllocator, TSetAllocator>(Forward<TPredicate>(Pred));
 }
 
-template <typename TEnumeratorKey, typename TPredicate>
+template <typename TSetAllocator = FDefaultSetAllocator, typename TEnumeratorKey, typename TPredicate>
 auto ExceptBy(TEnumeratorKey&& Key, TPredicate&& Pred)
 {
-	return Linq::TGeneratorExceptBy<TEnumeratorKey, TPredicate>(MoveTemp(Key), MoveTemp(Pred));
+	return Linq::TGeneratorExceptBy<TEnumeratorKey, TPredicate, TSetAllocator>(Forward<TEnumeratorKey>(Key), Forward<TPredicate>(Pred));
+}
+
+template <typename TSetAllocator = FDefaultSetAllocator, typename TEnumeratorKey, typename TPredicate>
+auto IntersectBy(TEnumeratorKey&& Key, TPredicate&& Pred)
+{
+	return Linq::TGeneratorIntersectBy<TEnumeratorKey, TPredicate, TSetAllocator>(Forward<TEnumeratorKey>(Key), Forward<TPredicate>(Pred));
+}
+
+template <typename TSetAllocator = FDefaultSetAllocator, typename TEnumeratorSecond, typename TPredicate>
+auto UnionBy(TEnumeratorSecond&& Second, TPredicate&& Pred)
+{
+	return Linq::TGeneratorUnionBy<TEnumeratorSecond, TPredicate, TSetAllocator>(Forward<TEnumeratorSecond>(Second), Forward<TPredicate>(Pred));
+}
+
+template <typename TEnumeratorSecond>
+auto Concat(TEnumeratorSecond&& Second)
+{
+	return Linq::TGeneratorConcat<TEnumeratorSecond>(Forward<TEnumeratorSecond>(Second));
+}
+
+template <typename TEnumeratorSecond, typename TPredicate>
+auto Zip(TEnumeratorSecond&& Second, TPredicate&& Pred)
+{
+	return Linq::TGeneratorZip<TEnumeratorSecond, TPredicate>(Forward<TEnumeratorSecond>(Second), Forward<TPredicate>(Pred));
+}
+
+template <typename TPredicate>
+auto SelectMany(TPredicate&& Pred)
+{
+	return Linq::TGeneratorSelectMany<TPredicate>(Forward<TPredicate>(Pred));
+}
+
+// Results follow the outer order; IsSmallerSideHashed lets a smaller outer side be hashed instead, giving up that order.
+template <typename TAllocator = FDefaultAllocator, typename TSetAllocator = FDefaultSetAllocator, typename TEnumeratorInner, typename TOuterKey, typename TInnerKey, typename TResult>
+auto Join(TEnumeratorInner&& Inner, TOuterKey&& OuterKey, TInnerKey&& InnerKey, TResult&& ResultSelector, bool IsSmallerSideHashed = false)
+{
+	return Linq::TGeneratorJoin<TEnumeratorInner, TOuterKey, TInnerKey, TResult, TAllocator, TSetAllocator>(Forward<TEnumeratorInner>(Inner), Forward<TOuterKey>(OuterKey), Forward<TInnerKey>(InnerKey), Forward<TResult>(ResultSelector), IsSmallerSideHashed);
+}
+
+template <typename TAllocator = FDefaultAllocator, typename TSetAllocator = FDefaultSetAllocator, typename TEnumeratorInner, typename TOuterKey, typename TInnerKey, typename TResult>
+auto GroupJoin(TEnumeratorInner&& Inner, TOuterKey&& OuterKey, TInnerKey&& InnerKey, TResult&& ResultSelector)
+{
+	return Linq::TGeneratorGroupJoin<TEnumeratorInner, TOuterKey, TInnerKey, TResult, TAllocator, TSetAllocator>(Forward<TEnumeratorInner>(Inner), Forward<TOuterKey>(OuterKey), Forward<TInnerKey>(InnerKey), Forward<TResult>(ResultSelector));
+}
+
+inline auto AsParallel(int ChunkSize = 1024)
+{
+	return Linq::TGeneratorAsParallel(ChunkSize);
+}
+
+// Runs Query a budget at a time; call Tick() once per frame until it returns true, then OnComplete receives the elements.
+template <typename TEnumerator, typename TCallback>
+auto RunBudgeted(TEnumerator&& Query, const Linq::FBudget& Budget, TCallback&& OnComplete)
+{
+	return Linq::TBudgetedRun<std::decay_t<TEnumerator>, std::decay_t<TCallback>>(std::decay_t<TEnumerator>(Forward<TEnumerator>(Query)), Budget, std::decay_t<TCallback>(Forward<TCallback>(OnComplete)));
 }
@@ -0,0 +1,19 @@
+#pragma once
+#include "Linq.h"
+#include "UObject/UObjectIterator.h"
+#include "EngineUtils.h"
+
+// Object and actor sources. The class and flag filters are applied by the engine iterators themselves,
+// so only matching objects ever reach the pipeline and nothing is gathered into an array first.
+
+template <typename T>
+auto FromObjects(EObjectFlags ExclusionFlags = RF_ClassDefaultObject, bool IncludeDerivedClasses = true, EInternalObjectFlags InternalExclusionFlags = EInternalObjectFlags::None)
+{
+	return FromIterator<TObjectIterator<T>>(ExclusionFlags, IncludeDerivedClasses, InternalExclusionFlags);
+}
+
+template <typename T>
+auto FromActors(const UWorld* World, TSubclassOf<T> Class = T::StaticClass(), EActorIteratorFlags Flags = EActorIteratorFlags::OnlyActiveLevels | EActorIteratorFlags::SkipPendingKill)
+{
+	return FromIterator<TActorIterator<T>>(World, Class, Flags);
+}
@@ -0,0 +1,449 @@
+#pragma once
+#include "Linq.h"
+#include "Algo/BinarySearch.h"
+
+// Materialized views: a Query<T>() pipeline of Where/Select stages, optionally ending in OrderBy (or TopBy) or GroupBy,
+// kept up to date from add/update/remove deltas instead of being re-run over the whole source.
+// Each source element is identified by a caller-chosen id (an index, a handle, an actor pointer...).
+
+namespace Linq
+{
+	template <typename TEnumerator>
+	struct TViewStages
+	{
+		static_assert(sizeof(TEnumerator) == 0, "A view supports Query<T>() followed by Where and Select, optionally ending in OrderBy, TopBy, OrderBy >> Take or GroupBy");
+	};
+
+	// Runs one source element through the streaming stages; Sink sees it only if it would reach the next stage.
+	template <typename TElementType>
+	struct TViewStages<TEnumeratorArray<TElementType>>
+	{
+		typedef TElementType SourceType;
+
+		template <typename TSink>
+		static void Apply(TEnumeratorArray<TElementType>& Stage, SourceType& Element, TSink&& Sink)
+		{
+			Sink(Element);
+		}
+	};
+
+	template <typename TEnumerator, typename TPredicate>
+	struct TViewStages<TEnumeratorWhere<TEnumerator, TPredicate>>
+	{
+		typedef typename TViewStages<TEnumerator>::SourceType SourceType;
+
+		template <typename TSink>
+		static void Apply(TEnumeratorWhere<TEnumerator, TPredicate>& Stage, SourceType& Element, TSink&& Sink)
+		{
+			TViewStages<TEnumerator>::Apply(Stage.Enumerator, Element, [&Stage, &Sink](typename TEnumerator::ElementType& Value)
+			{
+				if (Stage.Pred(Value))
+				{
+					Sink(Value);
+				}
+			});
+		}
+	};
+
+	template <typename TEnumerator, typename TPredicate>
+	struct TViewStages<TEnumeratorSelect<TEnumerator, TPredicate>>
+	{
+		typedef typename TViewStages<TEnumerator>::SourceType SourceType;
+
+		template <typename TSink>
+		static void Apply(TEnumeratorSelect<TEnumerator, TPredicate>& Stage, SourceType& Element, TSink&& Sink)
+		{
+			TViewStages<TEnumerator>::Apply(Stage.Enumerator, Element, [&Stage, &Sink](typename TEnumerator::ElementType& Value)
+			{
+				auto&& Projected = Stage.Pred(Value);
+				Sink(Projected);
+			});
+		}
+	};
+
+	// Where/Select only: results are kept unordered and removed by swapping the last one into the hole.
+	template <typename TQuery, typename TIdType>
+	struct TMaterializedView
+	{
+	public:
+		typedef TViewStages<TQuery> StagesType;
+		typedef typename StagesType::SourceType SourceType;
+		typedef std::remove_const_t<typename TQuery::ElementType> ElementType;
+		TQuery Query;
+		TArray<ElementType> Values;
+		TArray<TIdType> Ids;
+		TMap<TIdType, int> Slots;
+
+		explicit TMaterializedView(TQuery&& Query) : Query(MoveTemp(Query))
+		{
+		}
+
+		void Add(const TIdType& Id, SourceType& Element)
+		{
+			check(false == Slots.Contains(Id));
+			StagesType::Apply(Query, Element, [this, &Id](typename TQuery::ElementType& Value)
+			{
+				Slots.Add(Id, Values.Num());
+				Values.Emplace(Value);
+				Ids.Emplace(Id);
+			});
+		}
+
+		bool Remove(const TIdType& Id)
+		{
+			const int* Slot = Slots.Find(Id);
+			if (Slot == nullptr)
+			{
+				return false;
+			}
+			const int Index = *Slot;
+			Slots.Remove(Id);
+			Values.RemoveAtSwap(Index, 1, false);
+			Ids.RemoveAtSwap(Index, 1, false);
+			if (Index < Ids.Num())
+			{
+				Slots.FindChecked(Ids[Index]) = Index;
+			}
+			return true;
+		}
+
+		// A changed element that still passes is overwritten in place; otherwise it leaves or joins the view.
+		void Update(const TIdType& Id, SourceType& Element)
+		{
+			const int* Slot = Slots.Find(Id);
+			if (Slot == nullptr)
+			{
+				Add(Id, Element);
+				return;
+			}
+			const int Index = *Slot;
+			bool IsKept = false;
+			StagesType::Apply(Query, Element, [this, Index, &IsKept](typename TQuery::ElementType& Value)
+			{
+				Values[Index] = Value;
+				IsKept = true;
+			});
+			if (false == IsKept)
+			{
+				Remove(Id);
+			}
+		}
+
+		// Fills the view from a whole source; the ids are the source indices.
+		template <typename TSource>
+		void Build(TSource& Source)
+		{
+			Reset();
+			for (int SourceIndex = 0; SourceIndex < Source.Num(); ++SourceIndex)
+			{
+				Add(TIdType(SourceIndex), Source[SourceIndex]);
+			}
+		}
+
+		void Reset()
+		{
+			Values.Reset();
+			Ids.Reset();
+			Slots.Reset();
+		}
+
+		int Num() const
+		{
+			return Values.Num();
+		}
+
+		const TArray<ElementType>& Results() const
+		{
+			return Values;
+		}
+	};
+
+	// OrderBy: results stay sorted; a delta is a binary search plus one insert or remove in the result arrays.
+	// Equal keys keep the order in which their ids were first added, which matches the stable sort when ids follow source order.
+	// After TopBy or Take only the first TopCount are results; the rest are kept to refill them when a member leaves.
+	template <typename TEnumerator, typename TPredicate, bool IsAscending, typename TAllocator, typename TIdType>
+	struct TMaterializedView<TEnumeratorOrderBy<TEnumerator, TPredicate, IsAscending, TAllocator>, TIdType>
+	{
+	public:
+		typedef TEnumeratorOrderBy<TEnumerator, TPredicate, IsAscending, TAllocator> QueryType;
+		typedef TViewStages<TEnumerator> StagesType;
+		typedef typename StagesType::SourceType SourceType;
+		typedef std::remove_const_t<typename QueryType::ElementType> ElementType;
+		typedef typename QueryType::KeyType KeyType;
+
+		struct FEntry
+		{
+		public:
+			KeyType Key;
+			uint32 Sequence;
+
+			bool operator<(const FEntry& Other) const
+			{
+				if (Key < Other.Key)
+				{
+					return true;
+				}
+				if (Other.Key < Key)
+				{
+					return false;
+				}
+				return Sequence < Other.Sequence;
+			}
+		};
+
+		QueryType Query;
+		TArray<FEntry, TAllocator> Entries;
+		TArray<ElementType, TAllocator> Values;
+		TMap<TIdType, FEntry> Members;
+		// Every added id keeps its sequence while filtered out, so it returns to the same place among equal keys.
+		TMap<TIdType, uint32> Sequences;
+		uint32 NextSequence = 0;
+
+		explicit TMaterializedView(QueryType&& Query) : Query(MoveTemp(Query))
+		{
+		}
+
+		void Add(const TIdType& Id, SourceType& Element)
+		{
+			check(false == Sequences.Contains(Id));
+			Sequences.Add(Id, NextSequence);
+			Insert(Id, NextSequence++, Element);
+		}
+
+		bool Remove(const TIdType& Id)
+		{
+			Sequences.Remove(Id);
+			return RemoveEntry(Id);
+		}
+
+		// A changed element whose key did not move is overwritten in place; otherwise it is moved to its new rank.
+		void Update(const TIdType& Id, SourceType& Element)
+		{
+			const uint32* Found = Sequences.Find(Id);
+			if (Found == nullptr)
+			{
+				Add(Id, Element);
+				return;
+			}
+			const uint32 Sequence = *Found;
+			bool IsPassed = false;
+			StagesType::Apply(Query.Enumerator, Element, [this, &Id, Sequence, &IsPassed](typename TEnumerator::ElementType& Value)
+			{
+				IsPassed = true;
+				const FEntry Entry{KeyType(Query.Pred(Value)), Sequence};
+				if (const FEntry* Old = Members.Find(Id))
+				{
+					if (false == (Entry.Key < Old->Key) && false == (Old->Key < Entry.Key))
+					{
+						Values[Algo::LowerBound(Entries, *Old)] = Value;
+						return;
+					}
+					RemoveEntry(Id);
+				}
+				InsertEntry(Id, Entry, Value);
+			});
+			if (false == IsPassed)
+			{
+				RemoveEntry(Id);
+			}
+		}
+
+		// Fills the view from a whole source with one sort; the ids are the source indices.
+		template <typename TSource>
+		void Build(TSource& Source)
+		{
+			Reset();
+			TArray<FEntry, TAllocator> Unsorted;
+			TArray<ElementType, TAllocator> UnsortedValues;
+			Unsorted.Reserve(Source.Num());
+			UnsortedValues.Reserve(Source.Num());
+			for (int SourceIndex = 0; SourceIndex < Source.Num(); ++SourceIndex)
+			{
+				const uint32 Sequence = NextSequence++;
+				Sequences.Add(TIdType(SourceIndex), Sequence);
+				StagesType::Apply(Query.Enumerator, Source[SourceIndex], [this, SourceIndex, Sequence, &Unsorted, &UnsortedValues](typename TEnumerator::ElementType& Value)
+				{
+					const FEntry Entry{KeyType(Query.Pred(Value)), Sequence};
+					Members.Add(TIdType(SourceIndex), Entry);
+					Unsorted.Emplace(Entry);
+					UnsortedValues.Emplace(Value);
+				});
+			}
+			TArray<int, TAllocator> Order;
+			Order.Reserve(Unsorted.Num());
+			for (int Index = 0; Index < Unsorted.Num(); ++Index)
+			{
+				Order.Emplace(Index);
+			}
+			Algo::Sort(Order, [&Unsorted](int L, int R) { return Unsorted[L] < Unsorted[R]; });
+			Entries.Reserve(Order.Num());
+			Values.Reserve(Order.Num());
+			for (int Index : Order)
+			{
+				Entries.Emplace(Unsorted[Index]);
+				Values.Emplace(MoveTemp(UnsortedValues[Index]));
+			}
+		}
+
+		void Reset()
+		{
+			Entries.Reset();
+			Values.Reset();
+			Members.Reset();
+			Sequences.Reset();
+			NextSequence = 0;
+		}
+
+		int Num() const
+		{
+			return Query.TopCount >= 0 ? FMath::Min(Values.Num(), Query.TopCount) : Values.Num();
+		}
+
+		TArrayView<const ElementType> Results() const
+		{
+			return TArrayView<const ElementType>(Values.GetData(), Num());
+		}
+
+		bool RemoveEntry(const TIdType& Id)
+		{
+			const FEntry* Entry = Members.Find(Id);
+			if (Entry == nullptr)
+			{
+				return false;
+			}
+			const int Index = Algo::LowerBound(Entries, *Entry);
+			Entries.RemoveAt(Index, 1, false);
+			Values.RemoveAt(Index, 1, false);
+			Members.Remove(Id);
+			return true;
+		}
+
+		void Insert(const TIdType& Id, uint32 Sequence, SourceType& Element)
+		{
+			StagesType::Apply(Query.Enumerator, Element, [this, &Id, Sequence](typename TEnumerator::ElementType& Value)
+			{
+				InsertEntry(Id, FEntry{KeyType(Query.Pred(Value)), Sequence}, Value);
+			});
+		}
+
+		void InsertEntry(const TIdType& Id, const FEntry& Entry, typename TEnumerator::ElementType& Value)
+		{
+			const int Index = Algo::LowerBound(Entries, Entry);
+			Entries.Insert(Entry, Index);
+			Values.Insert(ElementType(Value), Index);
+			Members.Add(Id, Entry);
+		}
+	};
+
+	// OrderBy >> Take(K): Take already limited the OrderBy to its first K, so this is the same ordered view.
+	template <typename TEnumerator, typename TPredicate, bool IsAscending, typename TAllocator, typename TIdType>
+	struct TMaterializedView<TEnumeratorTake<TEnumeratorOrderBy<TEnumerator, TPredicate, IsAscending, TAllocator>>, TIdType>
+		: public TMaterializedView<TEnumeratorOrderBy<TEnumerator, TPredicate, IsAscending, TAllocator>, TIdType>
+	{
+	public:
+		typedef TMaterializedView<TEnumeratorOrderBy<TEnumerator, TPredicate, IsAscending, TAllocator>, TIdType> OrderedType;
+
+		explicit TMaterializedView(TEnumeratorTake<TEnumeratorOrderBy<TEnumerator, TPredicate, IsAscending, TAllocator>>&& Query) : OrderedType(MoveTemp(Query.Enumerator))
+		{
+		}
+	};
+
+	// GroupBy: keeps the number of elements in each group and which group every id is counted in.
+	template <typename TEnumerator, typename TPredicate, typename TAllocator, typename TSetAllocator, typename TIdType>
+	struct TMaterializedView<TEnumeratorGroupBy<TEnumerator, TPredicate, TAllocator, TSetAllocator>, TIdType>
+	{
+	public:
+		typedef TEnumeratorGroupBy<TEnumerator, TPredicate, TAllocator, TSetAllocator> QueryType;
+		typedef TViewStages<TEnumerator> StagesType;
+		typedef typename StagesType::SourceType SourceType;
+		typedef typename QueryType::KeySelectorType KeyType;
+		QueryType Query;
+		TMap<KeyType, int, TSetAllocator> GroupNums;
+		TMap<TIdType, KeyType> Members;
+
+		explicit TMaterializedView(QueryType&& Query) : Query(MoveTemp(Query))
+		{
+		}
+
+		void Add(const TIdType& Id, SourceType& Element)
+		{
+			check(false == Members.Contains(Id));
+			StagesType::Apply(Query.Enumerator, Element, [this, &Id](typename TEnumerator::ElementType& Value)
+			{
+				KeyType Key = Query.Pred(Value);
+				GroupNums.FindOrAdd(Key) += 1;
+				Members.Add(Id, MoveTemp(Key));
+			});
+		}
+
+		bool Remove(const TIdType& Id)
+		{
+			const KeyType* Key = Members.Find(Id);
+			if (Key == nullptr)
+			{
+				return false;
+			}
+			int& Num = GroupNums.FindChecked(*Key);
+			Num -= 1;
+			if (Num == 0)
+			{
+				GroupNums.Remove(*Key);
+			}
+			Members.Remove(Id);
+			return true;
+		}
+
+		void Update(const TIdType& Id, SourceType& Element)
+		{
+			Remove(Id);
+			Add(Id, Element);
+		}
+
+		// Fills the view from a whole source; the ids are the source indices.
+		template <typename TSource>
+		void Build(TSource& Source)
+		{
+			Reset();
+			for (int SourceIndex = 0; SourceIndex < Source.Num(); ++SourceIndex)
+			{
+				Add(TIdType(SourceIndex), Source[SourceIndex]);
+			}
+		}
+
+		void Reset()
+		{
+			GroupNums.Reset();
+			Members.Reset();
+		}
+
+		int Num(const KeyType& Key) const
+		{
+			const int* GroupNum = GroupNums.Find(Key);
+			return GroupNum ? *GroupNum : 0;
+		}
+
+		const TMap<KeyType, int, TSetAllocator>& Results() const
+		{
+			return GroupNums;
+		}
+	};
+
+	template <typename TIdType>
+	struct TGeneratorToView
+	{
+	public:
+		template <typename TEnumerator>
+		auto Gen(TEnumerator& Enumerator)
+		{
+			return TMaterializedView<TEnumerator, TIdType>(MoveTemp(Enumerator));
+		}
+	};
+}
+
+// Turns a Query<T>() pipeline into a live view fed with Add/Update/Remove deltas, e.g.
+// auto Threats = Query<AEnemy*>() >> Where(...) >> OrderBy(...) >> ToView<AEnemy*>();
+template <typename TIdType = int>
+auto ToView()
+{
+	return Linq::TGeneratorToView<TIdType>();
+}
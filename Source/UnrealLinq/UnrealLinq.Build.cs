@@ -22,6 +22,8 @@ public class UnrealLinq : ModuleRules
 			new string[]
 			{
 				"Core",
+				"CoreUObject",
+				"Engine",
 			}
 		);
 			
@@ -29,8 +31,6 @@ public class UnrealLinq : ModuleRules
 		PrivateDependencyModuleNames.AddRange(
 			new string[]
 			{
-				"CoreUObject",
-				"Engine",
 				"Slate",
 				"SlateCore",
 			}
@@ -44,5 +44,8 @@ public class UnrealLinq : ModuleRules
 		);
 		
 		CppStandard = CppStandardVersion.Cpp17;
+
+		// Set to 1 to record per-stage counters in Linq pipelines (STAT_Linq*, Insights scopes, Linq::CollectStats).
+		PublicDefinitions.Add("LINQ_INSTRUMENTATION=0");
 	}
 }
\ No newline at end of file